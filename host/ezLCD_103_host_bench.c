@@ -0,0 +1,196 @@
+/*
+ * @file   ezLCD_103_host_bench.c  <br>
+ * @author agent <br>
+ * @date   October 2026  <br>
+ * @brief  Bus-cost benchmark for the ezLCD+103 driver  <br>
+ * @defgroup ezLCD_103_host_bench Host Bus-Cost Benchmark
+ * @{
+ *
+ * Runs the cases in ezLCD_103_host_bench_cases.c and prints the report.
+ * Usage: bench [f_clk in Hz]
+ *
+ * Each case runs in a process of its own, forked before any case has run,
+ * so it starts from a freshly loaded driver whatever ran before it.
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "ezLCD_103_driver.h"
+#include "ezLCD_103_host_render.h"
+#include "ezLCD_103_host_bench.h"
+
+/*----------------------------------------------------------------------------*/
+/* CONSTANTS                                                                  */
+/*----------------------------------------------------------------------------*/
+#define TOUCH_MAX   16     /* Touch packets that may be queued at once */
+#define RATES       7      /* f_clk/2 ... f_clk/128 */
+
+/*----------------------------------------------------------------------------*/
+/* VARIABLES                                                                  */
+/*----------------------------------------------------------------------------*/
+static uint8_t touch[TOUCH_MAX];
+static uint8_t touch_head;
+static uint8_t touch_tail;
+
+static unsigned long f_clk = EZLCD_BENCH_FCLK;
+
+static uint32_t base_bytes;         /* Counts at ezLCD_bench_begin() */
+static uint32_t base_transactions;
+static uint32_t base_pixels;
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+void ezLCD_bench_touch(uint8_t packet)
+{
+  touch[touch_head] = packet;
+  touch_head = (touch_head + 1) % TOUCH_MAX;
+}
+
+void ezLCD_bench_begin(void)
+{
+  base_bytes        = ezLCD_host_bytes();
+  base_transactions = ezLCD_host_transactions();
+  base_pixels       = ezLCD_render_pixels();
+}
+
+/* Answers PING and CALIBRATE, and hands out queued touch packets on the next
+ * byte of any kind, the way the display reports them in ezButton mode */
+static uint8_t display_responder(uint8_t mosi)
+{
+  static uint8_t last;
+  uint8_t miso = 0x00;
+
+  if(last == 0x83)
+    miso = 0x38;
+  else if(last == 0xB6)
+    miso = 0x32;
+  else if(touch_tail != touch_head)
+  {
+    miso = touch[touch_tail];
+    touch_tail = (touch_tail + 1) % TOUCH_MAX;
+  }
+
+  last = mosi;
+  return miso;
+}
+
+static void print_header(const char *title)
+{
+  char    rate[8];
+  uint8_t i;
+
+  fprintf(stdout, "\n%-32s %6s %4s %7s    estimated time in us at SPI clock\n",
+          "", "", "", "");
+  fprintf(stdout, "%-32s %6s %4s %7s", title, "bytes", "CS", "pixels");
+  for(i = 1; i <= RATES; ++i)
+  {
+    sprintf(rate, "f/%u%s", 1u << i, (1u << i) == 4 ? "*" : "");
+    fprintf(stdout, " %8s", rate);
+  }
+  fprintf(stdout, "\n");
+}
+
+/* Measures one case and prints its line of the report */
+static void measure_case(const ezLCD_bench_case_t *bench)
+{
+  uint32_t bytes;
+  uint32_t transactions;
+  uint32_t pixels;
+  uint8_t  i;
+
+  ezLCD_host_reset();
+  ezLCD_host_keep_log(0);
+  ezLCD_host_set_responder(display_responder);
+  ezLCD_host_set_listener(ezLCD_render_listener);
+  ezLCD_render_reset();
+  ezLCD_render_picture_size(BACKGROUND_1_INDEX,
+                            BACKGROUND_1_WIDTH, BACKGROUND_1_HEIGHT);
+  touch_head = touch_tail = 0;
+  EZLCD_INIT_SPI();
+  ezLCD_state_invalidate();
+  ezLCD_event_harvest(EZLCD_HARVEST_OFF);     /* Empty the event queues */
+  ezLCD_event_harvest(EZLCD_HARVEST_BUTTONS); /* main.c uses ezButton */
+  ezLCD_bench_begin();
+
+  bench->run();
+
+  bytes        = ezLCD_host_bytes() - base_bytes;
+  transactions = ezLCD_host_transactions() - base_transactions;
+  pixels       = ezLCD_render_pixels() - base_pixels;
+
+  fprintf(stdout, "%-32s %6lu %4lu %7lu", bench->name, (unsigned long)bytes,
+          (unsigned long)transactions, (unsigned long)pixels);
+
+  for(i = 1; i <= RATES; ++i)
+  {
+    double cycles = (double)bytes * (8.0 * (1u << i) + EZLCD_BENCH_BYTE_CYCLES)
+                  + (double)transactions * EZLCD_BENCH_CS_CYCLES;
+    fprintf(stdout, " %8.1f", cycles * 1e6 / f_clk);
+  }
+  fprintf(stdout, "\n");
+}
+
+/* Runs a case in a child process so no driver state leaks between cases */
+static int run_case(const ezLCD_bench_case_t *bench)
+{
+  pid_t child;
+  int   status;
+
+  fflush(stdout);
+  child = fork();
+  if(child < 0)
+  {
+    perror("fork");
+    return 1;
+  }
+  if(child == 0)
+  {
+    measure_case(bench);
+    fflush(stdout);
+    _exit(0);
+  }
+
+  if(waitpid(child, &status, 0) != child ||
+     !WIFEXITED(status) || WEXITSTATUS(status))
+  {
+    fprintf(stderr, "case \"%s\" failed\n", bench->name);
+    return 1;
+  }
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  const ezLCD_bench_case_t *bench;
+  int failed = 0;
+
+  if(argc > 1) f_clk = strtoul(argv[1], 0, 0);
+  if(!f_clk)
+  {
+    fprintf(stderr, "usage: %s [f_clk in Hz]\n", argv[0]);
+    return 1;
+  }
+
+  fprintf(stdout, "ezLCD+103 bus cost, f_clk = %lu Hz, "
+          "%d cycles/byte and %d cycles/CS overhead, "
+          "* = EZLCD_INIT_SPI() rate\n",
+          f_clk, EZLCD_BENCH_BYTE_CYCLES, EZLCD_BENCH_CS_CYCLES);
+
+  print_header("function");
+  for(bench = ezLCD_bench_functions; bench->name; ++bench)
+    failed |= run_case(bench);
+
+  print_header("scenario");
+  for(bench = ezLCD_bench_scenarios; bench->name; ++bench)
+    failed |= run_case(bench);
+
+  return failed;
+}
+/** @} */ /* ezLCD_103_host_bench */
@@ -0,0 +1,79 @@
+/**
+ * @file   ezLCD_103_host_bench.h  <br>
+ * @author agent <br>
+ * @date   October 2026  <br>
+ * @brief  Bus-cost benchmark for the ezLCD+103 driver  <br>
+ * @defgroup ezLCD_103_host_bench Host Bus-Cost Benchmark
+ * @{
+ *
+ * The benchmark runs every public driver function, plus a few whole-screen
+ * scenarios taken from main.c, against the emulated SPI peripheral. For each
+ * one it reports the bytes sent, the chip select transactions, the pixels
+ * painted according to the reference renderer, and the estimated time on 
+ * the target for each SPI clock rate selectable with EZLCD_INIT_SPI(), from
+ * f_clk/2 to f_clk/128.
+ *
+ * The estimate is a simple model of the polled transfer loop:
+ *
+ * @f[ t = \frac{bytes \cdot (8 \cdot divider + EZLCD\_BENCH\_BYTE\_CYCLES) +
+ *            transactions \cdot EZLCD\_BENCH\_CS\_CYCLES}{f_{clk}} @f]
+ *
+ * The cases live in ezLCD_103_host_bench_cases.c, which must not include 
+ * <stdio.h> so that putchar() resolves to the driver's text box version.
+ */
+
+/* Used to prevent multiple inclusion of the header file */
+#ifndef EZLCD_HOST_BENCH_H
+#define EZLCD_HOST_BENCH_H
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include "ezLCD_103_common.h"
+
+/*----------------------------------------------------------------------------*/
+/* CONSTANTS                                                                  */
+/*----------------------------------------------------------------------------*/
+/** Default MCU clock in Hz, may be overridden on the command line */
+#define EZLCD_BENCH_FCLK         16000000UL
+/** MCU cycles spent per byte outside of the SPI shift itself */
+#define EZLCD_BENCH_BYTE_CYCLES  10
+/** MCU cycles spent per chip select assert/release pair */
+#define EZLCD_BENCH_CS_CYCLES    8
+
+/*----------------------------------------------------------------------------*/
+/* TYPEDEFS                                                                   */
+/*----------------------------------------------------------------------------*/
+/** One benchmark case */
+typedef struct
+{
+  const char *name;      /**< Name printed in the report */
+  void (*run)(void);     /**< Performs the driver calls being measured */
+} ezLCD_bench_case_t;
+
+/*----------------------------------------------------------------------------*/
+/* VARIABLES                                                                  */
+/*----------------------------------------------------------------------------*/
+/** Single function cases, terminated by an entry with a null name */
+extern const ezLCD_bench_case_t ezLCD_bench_functions[];
+/** Whole-screen scenarios, terminated by an entry with a null name */
+extern const ezLCD_bench_case_t ezLCD_bench_scenarios[];
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+/** Queues a touch packet the emulated display returns on the next byte,
+ *  so cases can exercise the event functions without blocking.
+ *
+ *  @par Parameters
+ *       - @a packet = Byte to return, e.g. an ezButton status byte.
+ */
+void ezLCD_bench_touch(uint8_t packet);
+
+/** Starts the measurement over, so that a case can first bring the display
+ *  and driver into the state it needs without counting that part.
+ */
+void ezLCD_bench_begin(void);
+
+#endif /* EZLCD_HOST_BENCH_H */
+/** @} */ /* ezLCD_103_host_bench */
@@ -0,0 +1,716 @@
+/*
+ * @file   ezLCD_103_host_bench_cases.c  <br>
+ * @author agent <br>
+ * @date   October 2026  <br>
+ * @brief  Cases measured by the bus-cost benchmark  <br>
+ * @defgroup ezLCD_103_host_bench Host Bus-Cost Benchmark
+ * @{
+ *
+ * One case per public driver function, followed by whole-screen scenarios
+ * which mirror what main.c does.
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include "ezLCD_103_driver.h"
+#include "ezLCD_103_host_bench.h"
+
+/*----------------------------------------------------------------------------*/
+/* BUTTON IDs (as in main.c)                                                  */
+/*----------------------------------------------------------------------------*/
+#define STAR        10
+#define POUND       11
+#define START       12
+#define STOP        13
+#define CALIBRATE   14
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTION CASES                                                             */
+/*----------------------------------------------------------------------------*/
+static void set_color_rgb(void)       { ezLCD_set_color_rgb(EZLCD_VIOLET); }
+static void set_alpha(void)           { ezLCD_set_alpha(128); }
+static void set_tr_color_rgb(void)    { ezLCD_set__tr_color_rgb(EZLCD_BLACK); }
+static void tr_color_none(void)       { ezLCD_tr_color_none(); }
+static void set_background(void)      { ezLCD_set_background_color(EZLCD_BLUE); }
+static void replace_color(void)
+{
+  ezLCD_replace_color(EZLCD_WHITE, EZLCD_BLACK);
+}
+static void set_xy(void)              { ezLCD_set_xy(160, 120); }
+static void set_x(void)               { ezLCD_set_x(160); }
+static void set_y(void)               { ezLCD_set_y(120); }
+static void save_position(void)       { ezLCD_save_position(1); }
+static void restore_position(void)    { ezLCD_restore_position(1); }
+static void draw_circle(void)         { ezLCD_draw_circle(50); }
+static void draw_circle_fill(void)    { ezLCD_draw_circle_fill(50); }
+static void draw_arc(void)            { ezLCD_draw_arc(50, 0, 90); }
+static void draw_pie(void)            { ezLCD_draw_pie(50, 0, 90); }
+static void draw_ellipse(void)        { ezLCD_draw_ellipse(60, 30); }
+static void draw_ellipse_fill(void)   { ezLCD_draw_ellipse_fill(60, 30); }
+static void draw_ellipse_arc(void)    { ezLCD_draw_ellipse_arc(60, 30, 0, 90); }
+static void draw_ellipse_pie(void)    { ezLCD_draw_ellipse_pie(60, 30, 0, 90); }
+static void clear(void)               { ezLCD_clear(); }
+static void fill(void)                { ezLCD_fill(); }
+static void fill_bound(void)          { ezLCD_fill_bound(EZLCD_WHITE); }
+static void set_display_frame(void)   { ezLCD_set_display_frame(1); }
+static void set_draw_frame(void)      { ezLCD_set_draw_frame(1); }
+static void put_picture_rom(void)     { ezLCD_put_picture_rom(1); }
+static void put_picture_sd(void)
+{
+  char path[] = "\\Bitmaps\\stony_brook.jpg";
+  ezLCD_put_picture_sd(path, sizeof path - 1);
+}
+static void draw_line(void)           { ezLCD_draw_line(300, 200); }
+static void draw_h_line(void)         { ezLCD_draw_h_line(300); }
+static void draw_v_line(void)         { ezLCD_draw_v_line(200); }
+static void set_pen_size(void)        { ezLCD_set_pen_size(2); }
+static void set_pen_height(void)      { ezLCD_set_pen_height(2); }
+static void plot_pixel(void)          { ezLCD_set_plot_pixel(); }
+static void plot_pixel_xy(void)       { ezLCD_set_plot_pixel_xy(10, 10); }
+static void draw_rect(void)           { ezLCD_draw_rect(200, 150); }
+static void draw_rect_fill(void)      { ezLCD_draw_rect_fill(200, 150); }
+static void draw_polygon(void)
+{
+  uint16_t x[] = { 200, 150, 100 };
+  uint16_t y[] = { 200, 220, 180 };
+  ezLCD_draw_polygon(3, x, y);
+}
+static void set_edit_rectangle(void)  { ezLCD_set_edit_rectangle(0, 0, 100, 50); }
+static void set_brightness(void)      { ezLCD_set_brightness(80); }
+static void backlight_off(void)       { ezLCD_backlight_off(); }
+static void backlight_on(void)        { ezLCD_backlight_on(); }
+static void ping(void)                { ezLCD_ping(); }
+static void set_bitmap_font(void)     { ezLCD_set_bitmap_font(ISO_8X13_INDEX); }
+static void set_true_type_font(void)
+{
+  ezLCD_set_true_type_font(DEJAVUSANS_BOLD, 32, 32);
+}
+static void set_ttf_unicode_base(void) { ezLCD_set_ttf_unicode_base(0x394); }
+static void init_putchar(void)
+{
+  ezLCD_init_putchar(5, 5, 165-5, 70-5, 2, 2, 32,32,EZLCD_WHITE,EZLCD_VIOLET);
+}
+
+/* Sets up the text box and font of main.c without counting them */
+static void text_box(void)
+{
+  init_putchar();
+  ezLCD_set_true_type_font(DEJAVUSANS_BOLD,32,32);
+  ezLCD_bench_begin();
+}
+
+static void lcd_putchar(void)         { ezLCD_putchar('7'); }
+static void lcd_putchar_bg(void)      { ezLCD_putchar_bg('7'); }
+static void text_box_putchar(void)    { text_box(); putchar('7'); }
+static void lcd_puts(void)            { text_box(); ezLCD_puts("0123456789"); }
+static void lcd_puts_bg(void)
+{
+  text_box();
+  ezLCD_puts_bg("0123456789");
+}
+static void button_define_long(void)
+{
+  ezLCD_button_define_long(START,
+                           EZLCD_BUTTON_UP,
+                           START_BUTTON_EZLCD_BUTTON_UP_INDEX,
+                           START_BUTTON_EZLCD_BUTTON_DOWN_INDEX,
+                           START_BUTTON_DISABLED_INDEX,
+                           215,
+                           5,
+                           START_BUTTON_WIDTH,
+                           START_BUTTON_HEIGHT);
+}
+static void set_touch_protocol(void)  { ezLCD_set_touch_protocol(ezButton); }
+static void set_button_state(void)    { ezLCD_set_button_state(3, EZLCD_BUTTON_DOWN); }
+static void calibrate_screen(void)    { ezLCD_calibrate_screen(); }
+static void all_buttons_up(void)      { ezLCD_all_buttons_up(); }
+static void deactivate_all(void)      { ezLCD_deactivate_all_buttons(); }
+static void wait_for_event(void)
+{
+  ezLCD_bench_touch(0x40 | 3);                /* Button 3 DOWN */
+  ezLCD_bench_touch(0x80 | 3);                /* Button 3 UP */
+  ezLCD_wait_for_event();
+}
+static void poll_event(void)
+{
+  uint8_t id;
+  ezLCD_poll_event(&id);                       /* Idle: nothing queued */
+}
+
+const ezLCD_bench_case_t ezLCD_bench_functions[] =
+{
+  { "ezLCD_set_color_rgb",          set_color_rgb        },
+  { "ezLCD_set_alpha",              set_alpha            },
+  { "ezLCD_set__tr_color_rgb",      set_tr_color_rgb     },
+  { "ezLCD_tr_color_none",          tr_color_none        },
+  { "ezLCD_set_background_color",   set_background       },
+  { "ezLCD_replace_color",          replace_color        },
+  { "ezLCD_set_xy",                 set_xy               },
+  { "ezLCD_set_x",                  set_x                },
+  { "ezLCD_set_y",                  set_y                },
+  { "ezLCD_save_position",          save_position        },
+  { "ezLCD_restore_position",       restore_position     },
+  { "ezLCD_draw_circle",            draw_circle          },
+  { "ezLCD_draw_circle_fill",       draw_circle_fill     },
+  { "ezLCD_draw_arc",               draw_arc             },
+  { "ezLCD_draw_pie",               draw_pie             },
+  { "ezLCD_draw_ellipse",           draw_ellipse         },
+  { "ezLCD_draw_ellipse_fill",      draw_ellipse_fill    },
+  { "ezLCD_draw_ellipse_arc",       draw_ellipse_arc     },
+  { "ezLCD_draw_ellipse_pie",       draw_ellipse_pie     },
+  { "ezLCD_clear",                  clear                },
+  { "ezLCD_fill",                   fill                 },
+  { "ezLCD_fill_bound",             fill_bound           },
+  { "ezLCD_set_display_frame",      set_display_frame    },
+  { "ezLCD_set_draw_frame",         set_draw_frame       },
+  { "ezLCD_put_picture_rom",        put_picture_rom      },
+  { "ezLCD_put_picture_sd",         put_picture_sd       },
+  { "ezLCD_draw_line",              draw_line            },
+  { "ezLCD_draw_h_line",            draw_h_line          },
+  { "ezLCD_draw_v_line",            draw_v_line          },
+  { "ezLCD_set_pen_size",           set_pen_size         },
+  { "ezLCD_set_pen_height",         set_pen_height       },
+  { "ezLCD_set_plot_pixel",         plot_pixel           },
+  { "ezLCD_set_plot_pixel_xy",      plot_pixel_xy        },
+  { "ezLCD_draw_rect",              draw_rect            },
+  { "ezLCD_draw_rect_fill",         draw_rect_fill       },
+  { "ezLCD_draw_polygon (3)",       draw_polygon         },
+  { "ezLCD_set_edit_rectangle",     set_edit_rectangle   },
+  { "ezLCD_set_brightness",         set_brightness       },
+  { "ezLCD_backlight_off",          backlight_off        },
+  { "ezLCD_backlight_on",           backlight_on         },
+  { "ezLCD_ping",                   ping                 },
+  { "ezLCD_set_bitmap_font",        set_bitmap_font      },
+  { "ezLCD_set_true_type_font",     set_true_type_font   },
+  { "ezLCD_set_ttf_unicode_base",   set_ttf_unicode_base },
+  { "ezLCD_init_putchar",           init_putchar         },
+  { "ezLCD_putchar",                lcd_putchar          },
+  { "ezLCD_putchar_bg",             lcd_putchar_bg       },
+  { "putchar (text box)",           text_box_putchar     },
+  { "ezLCD_puts (10 chars)",        lcd_puts             },
+  { "ezLCD_puts_bg (10 chars)",     lcd_puts_bg          },
+  { "ezLCD_button_define_long",     button_define_long   },
+  { "ezLCD_set_touch_protocol",     set_touch_protocol   },
+  { "ezLCD_set_button_state",       set_button_state     },
+  { "ezLCD_calibrate_screen",       calibrate_screen     },
+  { "ezLCD_all_buttons_up",         all_buttons_up       },
+  { "ezLCD_deactivate_all_buttons", deactivate_all       },
+  { "ezLCD_wait_for_event",         wait_for_event       },
+  { "ezLCD_poll_event (idle)",      poll_event           },
+  { 0, 0 }
+};
+
+/*----------------------------------------------------------------------------*/
+/* SCENARIOS                                                                  */
+/*----------------------------------------------------------------------------*/
+/* Same layout as draw_number_pad() in main.c */
+static void number_pad(uint8_t num_pad_x, uint8_t num_pad_y)
+{
+  static const uint8_t col[] = { 1, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 2 };
+  static const uint8_t row[] = { 3, 0, 0, 0, 1, 1, 1, 2, 2, 2, 3, 3 };
+  uint8_t id;
+
+  for(id = 0; id <= POUND; ++id)
+    ezLCD_button_define_long(id,
+                             EZLCD_BUTTON_UP,
+                             ZERO_BUTTON_EZLCD_BUTTON_UP_INDEX + 3 * id,
+                             ZERO_BUTTON_EZLCD_BUTTON_DOWN_INDEX + 3 * id,
+                             ZERO_BUTTON_DISABLED_INDEX + 3 * id,
+                             num_pad_x + col[id] * 55,
+                             num_pad_y + row[id] * 40,
+                             id < STAR ? ONE_BUTTON_WIDTH : STAR_BUTTON_WIDTH,
+                             id < STAR ? ONE_BUTTON_HEIGHT : STAR_BUTTON_HEIGHT);
+}
+
+static void control_buttons(uint8_t calibrate_first)
+{
+  if(calibrate_first)
+    ezLCD_button_define_long(CALIBRATE, EZLCD_BUTTON_UP,
+                             CALIBRATE_BUTTON_EZLCD_BUTTON_UP_INDEX,
+                             CALIBRATE_BUTTON_EZLCD_BUTTON_DOWN_INDEX,
+                             CALIBRATE_BUTTON_DISABLED_INDEX, 215, 115,
+                             CALIBRATE_BUTTON_WIDTH, CALIBRATE_BUTTON_HEIGHT);
+  ezLCD_button_define_long(START, EZLCD_BUTTON_UP,
+                           START_BUTTON_EZLCD_BUTTON_UP_INDEX,
+                           START_BUTTON_EZLCD_BUTTON_DOWN_INDEX,
+                           START_BUTTON_DISABLED_INDEX, 215, 5,
+                           START_BUTTON_WIDTH, START_BUTTON_HEIGHT);
+  ezLCD_button_define_long(STOP, EZLCD_BUTTON_UP,
+                           STOP_BUTTON_EZLCD_BUTTON_UP_INDEX,
+                           STOP_BUTTON_EZLCD_BUTTON_DOWN_INDEX,
+                           STOP_BUTTON_DISABLED_INDEX, 215, 60,
+                           STOP_BUTTON_WIDTH, STOP_BUTTON_HEIGHT);
+  if(!calibrate_first)
+    ezLCD_button_define_long(CALIBRATE, EZLCD_BUTTON_UP,
+                             CALIBRATE_BUTTON_EZLCD_BUTTON_UP_INDEX,
+                             CALIBRATE_BUTTON_EZLCD_BUTTON_DOWN_INDEX,
+                             CALIBRATE_BUTTON_DISABLED_INDEX, 215, 115,
+                             CALIBRATE_BUTTON_WIDTH, CALIBRATE_BUTTON_HEIGHT);
+}
+
+/* The START handler in main.c */
+static void start_page(void)
+{
+  ezLCD_set_draw_frame(1);
+  ezLCD_deactivate_all_buttons();
+  ezLCD_set_xy(0,0);
+  ezLCD_put_picture_rom(BACKGROUND_1_INDEX);
+  number_pad(5, 80);
+  control_buttons(0);
+  ezLCD_init_putchar(5, 5, 165-5, 70-5, 2, 2, 32,32,EZLCD_WHITE,EZLCD_VIOLET);
+  ezLCD_set_true_type_font(DEJAVUSANS_BOLD,32,32);
+  ezLCD_set_display_frame(1);
+}
+
+/* A number pad key in column @a col and row @a row of the pad */
+#define KEY(id, col, row, width, height)                                      \
+  { id, EZLCD_BUTTON_UP, ZERO_BUTTON_EZLCD_BUTTON_UP_INDEX + 3 * (id),        \
+    ZERO_BUTTON_EZLCD_BUTTON_DOWN_INDEX + 3 * (id),                           \
+    ZERO_BUTTON_DISABLED_INDEX + 3 * (id),                                    \
+    5 + (col) * 55, 80 + (row) * 40, width, height }
+#define DIGIT(id, col, row)                                                   \
+  KEY(id, col, row, ONE_BUTTON_WIDTH, ONE_BUTTON_HEIGHT)
+
+#define START_KEY                                                             \
+  { START, EZLCD_BUTTON_UP, START_BUTTON_EZLCD_BUTTON_UP_INDEX,               \
+    START_BUTTON_EZLCD_BUTTON_DOWN_INDEX, START_BUTTON_DISABLED_INDEX,        \
+    215, 5, START_BUTTON_WIDTH, START_BUTTON_HEIGHT }
+#define STOP_KEY                                                              \
+  { STOP, EZLCD_BUTTON_UP, STOP_BUTTON_EZLCD_BUTTON_UP_INDEX,                 \
+    STOP_BUTTON_EZLCD_BUTTON_DOWN_INDEX, STOP_BUTTON_DISABLED_INDEX,          \
+    215, 60, STOP_BUTTON_WIDTH, STOP_BUTTON_HEIGHT }
+#define CALIBRATE_KEY                                                         \
+  { CALIBRATE, EZLCD_BUTTON_UP, CALIBRATE_BUTTON_EZLCD_BUTTON_UP_INDEX,       \
+    CALIBRATE_BUTTON_EZLCD_BUTTON_DOWN_INDEX,                                 \
+    CALIBRATE_BUTTON_DISABLED_INDEX,                                          \
+    215, 115, CALIBRATE_BUTTON_WIDTH, CALIBRATE_BUTTON_HEIGHT }
+
+/* The fifteen buttons of the START page in ID order, in flash as main.c
+ * keeps them for ezLCD_button_page() */
+static const EZLCD_FLASH ezLCD_button_t page_start[POUND + 4] =
+{
+  DIGIT(0, 1, 3), DIGIT(1, 0, 0), DIGIT(2, 1, 0), DIGIT(3, 2, 0),
+  DIGIT(4, 0, 1), DIGIT(5, 1, 1), DIGIT(6, 2, 1),
+  DIGIT(7, 0, 2), DIGIT(8, 1, 2), DIGIT(9, 2, 2),
+  KEY(STAR,  0, 3, STAR_BUTTON_WIDTH, STAR_BUTTON_HEIGHT),
+  KEY(POUND, 2, 3, STAR_BUTTON_WIDTH, STAR_BUTTON_HEIGHT),
+  START_KEY,
+  STOP_KEY,
+  CALIBRATE_KEY
+};
+
+/* The buttons of the STOP page */
+static const EZLCD_FLASH ezLCD_button_t page_stop[3] =
+{
+  CALIBRATE_KEY,
+  START_KEY,
+  STOP_KEY
+};
+
+/* Copies the START page into RAM, for the functions which take RAM tables */
+static void start_buttons(ezLCD_button_t *buttons)
+{
+  uint8_t id;
+
+  for(id = 0; id < POUND + 4; ++id)
+    buttons[id] = page_start[id];
+}
+
+/* The START page with all fifteen buttons defined in one batch */
+static void start_page_batch(void)
+{
+  ezLCD_button_t buttons[POUND + 4];
+
+  start_buttons(buttons);
+
+  ezLCD_set_draw_frame(1);
+  ezLCD_deactivate_all_buttons();
+  ezLCD_set_xy(0,0);
+  ezLCD_put_picture_rom(BACKGROUND_1_INDEX);
+  ezLCD_button_define_batch(buttons, POUND + 4);
+  ezLCD_init_putchar(5, 5, 165-5, 70-5, 2, 2, 32,32,EZLCD_WHITE,EZLCD_VIOLET);
+  ezLCD_set_true_type_font(DEJAVUSANS_BOLD,32,32);
+  ezLCD_set_display_frame(1);
+}
+
+/* The STOP handler in main.c */
+static void stop_page(void)
+{
+  ezLCD_set_draw_frame(1);
+  ezLCD_deactivate_all_buttons();
+  ezLCD_set_xy(0,0);
+  ezLCD_put_picture_rom(BACKGROUND_1_INDEX);
+  control_buttons(1);
+  ezLCD_set_display_frame(1);
+}
+
+/* The STOP and START handlers of main.c with button pages: the display
+ * already holds the other page's buttons and only the difference is sent */
+static void page_background(void)
+{
+  ezLCD_set_draw_frame(1);
+  ezLCD_set_xy(0,0);
+  ezLCD_put_picture_rom(BACKGROUND_1_INDEX);
+}
+
+static void page_switch(uint8_t to_start)
+{
+  /* As main.c does it: START page at power up, then STOP */
+  ezLCD_button_page(page_start, POUND + 4, 1);
+  if(to_start)
+    ezLCD_button_page(page_stop, 3, 1);
+  ezLCD_bench_begin();
+
+  page_background();
+  if(to_start)
+  {
+    ezLCD_button_page(page_start, POUND + 4, 1);
+    ezLCD_init_putchar(5, 5, 165-5, 70-5, 2, 2, 32,32,EZLCD_WHITE,EZLCD_VIOLET);
+    ezLCD_set_true_type_font(DEJAVUSANS_BOLD,32,32);
+  }
+  else
+    ezLCD_button_page(page_stop, 3, 1);
+  ezLCD_set_display_frame(1);
+}
+
+static void start_page_cached(void)
+{
+  page_switch(1);
+}
+
+static void stop_page_cached(void)
+{
+  page_switch(0);
+}
+
+/* The same switches as main.c makes them: the STOP page kept in a frame by
+ * ezLCD_page_show(), the START page, whose text changes, drawn on the back
+ * frame and presented */
+static void draw_cached_stop(void)
+{
+  ezLCD_set_xy(0,0);
+  ezLCD_put_picture_rom(BACKGROUND_1_INDEX);
+  ezLCD_button_page(page_stop, 3, 1);
+}
+
+static ezLCD_page_t stop_frame_page = EZLCD_PAGE(draw_cached_stop);
+
+static void present_start(void)
+{
+  ezLCD_begin_frame();
+  ezLCD_set_xy(0,0);
+  ezLCD_put_picture_rom(BACKGROUND_1_INDEX);
+  ezLCD_button_page(page_start, POUND + 4, 1);
+  ezLCD_present();
+  ezLCD_button_page(page_start, POUND + 4, 0);
+  ezLCD_init_putchar(5, 5, 165-5, 70-5, 2, 2, 32,32,EZLCD_WHITE,EZLCD_VIOLET);
+  ezLCD_set_true_type_font(DEJAVUSANS_BOLD,32,32);
+}
+
+static void frame_page_switch(uint8_t to_start)
+{
+  /* STOP drawn at power up, START shown, then STOP */
+  ezLCD_page_invalidate_all();
+  ezLCD_page_prepare(&stop_frame_page);
+  present_start();
+  if(to_start)
+  {
+    ezLCD_page_show(&stop_frame_page);
+    ezLCD_button_page(page_stop, 3, 0);
+  }
+  ezLCD_bench_begin();
+
+  if(to_start)
+    present_start();
+  else
+  {
+    ezLCD_page_show(&stop_frame_page);
+    ezLCD_button_page(page_stop, 3, 0);
+  }
+}
+
+static void start_page_frame(void)
+{
+  frame_page_switch(1);
+}
+
+static void stop_page_frame(void)
+{
+  frame_page_switch(0);
+}
+
+/* The START page recorded once into a display list and replayed */
+static void start_page_replay(void)
+{
+  static uint8_t list[400];
+
+  ezLCD_display_list_begin(list, sizeof(list));
+  start_page();
+  if(ezLCD_display_list_end())
+    ezLCD_display_list_play(list);
+}
+
+/* Ten digits typed on the number pad and printed with printf("%d") */
+static void digits(void)
+{
+  uint8_t i;
+
+  for(i = 0; i < 10; ++i)
+    putchar('0' + i);
+}
+
+static void type_digits(void)
+{
+  text_box();
+  digits();
+}
+
+/* The same ten digits through buffered putchar() */
+static void buffered_digits(void)
+{
+  text_box();
+  ezLCD_putchar_buffer(1);
+  digits();
+  ezLCD_putchar_buffer(0);
+}
+
+/* The same ten digits as one string */
+static void puts_digits(void)
+{
+  text_box();
+  ezLCD_puts("0123456789");
+}
+
+/* A log of 100 short lines in a 10 row text box: cleared whenever it fills
+ * up, kept as a console refreshed on every line, and as a console refreshed
+ * once per 10 lines as the rate limit would at 4 ms per line and 40 ticks */
+static void log_line(uint8_t n)
+{
+  char line[9] = "line 00\n";
+
+  line[5] = '0' + n / 10;
+  line[6] = '0' + n % 10;
+  ezLCD_puts(line);
+}
+
+static void log_lines(uint8_t console, uint8_t every)
+{
+  uint8_t n;
+
+  ezLCD_init_putchar(5, 5, 300, 200, 2, 2, 16,16,EZLCD_WHITE,EZLCD_BLACK);
+  if(console)
+    ezLCD_console_begin(every ? 0xFFFF : 0);
+  ezLCD_bench_begin();
+
+  for(n = 0; n < 100; ++n)
+  {
+    log_line(n);
+    if(every && (n % every) == every - 1)
+      ezLCD_console_refresh();
+  }
+}
+
+static void log_text_box(void)      { log_lines(0, 0);  }
+static void log_console(void)       { log_lines(1, 0);  }
+static void log_console_limit(void) { log_lines(1, 10); }
+
+/* A key pressed and released while the START page is redrawn, picked up
+ * afterwards without any no-op bytes */
+static void touch_during_redraw(void)
+{
+  uint8_t id;
+
+  ezLCD_bench_touch(0x40 | 7);
+  ezLCD_bench_touch(0x80 | 7);
+  start_page();
+  ezLCD_poll_event(&id);
+  ezLCD_poll_event(&id);
+}
+
+/* A long press: the display repeats the DOWN packet before the UP */
+static void repeated_press(void)
+{
+  uint8_t i;
+
+  for(i = 0; i < 5; ++i)
+    ezLCD_bench_touch(0x40 | 7);
+  ezLCD_bench_touch(0x80 | 7);
+  ezLCD_wait_for_event();
+}
+
+/* One key press handled by the main loop: touch, release and echo */
+static void key_press(void)
+{
+  text_box();
+  ezLCD_bench_touch(0x40 | 7);
+  ezLCD_bench_touch(0x80 | 7);
+  putchar('0' + ezLCD_wait_for_event());
+}
+
+static void echo_digit(uint8_t id, ezLCD_event_t event)
+{
+  (void)event;
+  putchar('0' + id);
+}
+
+/* The same key press handled through a dispatch table */
+static void key_press_dispatch(void)
+{
+  static ezLCD_button_handlers_t handlers;
+
+  text_box();
+  ezLCD_button_on(&handlers, 7, EZLCD_EVENT_RELEASE, echo_digit);
+  ezLCD_button_handlers_use(&handlers);
+  ezLCD_bench_touch(0x40 | 7);
+  ezLCD_bench_touch(0x80 | 7);
+  while(ezLCD_button_dispatch() != EZLCD_EVENT_RELEASE);
+  ezLCD_button_handlers_use(0);
+}
+
+/* Keys of 32 x 40 pixels of the calibratedXY keyboard, ten to a row */
+#define HIT_KEY(column, row)                                                  \
+  { (column) * 32, (row) * 40, 32, 40, (row) * 10 + (column) }
+#define HIT_ROW(row)                                                          \
+  HIT_KEY(0, row), HIT_KEY(1, row), HIT_KEY(2, row), HIT_KEY(3, row),         \
+  HIT_KEY(4, row), HIT_KEY(5, row), HIT_KEY(6, row), HIT_KEY(7, row),         \
+  HIT_KEY(8, row), HIT_KEY(9, row)
+
+/* A tap on a calibratedXY keyboard of 40 keys, 10 x 4 keys of 32 x 40
+ * pixels, looked up in a hit index instead of being defined as buttons */
+static void calibrated_tap(void)
+{
+  static const EZLCD_FLASH ezLCD_hit_region_t keys[40] =
+  {
+    HIT_ROW(0), HIT_ROW(1), HIT_ROW(2), HIT_ROW(3)
+  };
+  static ezLCD_hit_index_t keyboard;
+  ezLCD_touch_t touch;
+  uint16_t      key = EZLCD_HIT_NONE;
+
+  ezLCD_hit_index_build(&keyboard, keys, 40);
+  ezLCD_event_harvest(EZLCD_HARVEST_TOUCH);   /* As calibratedXY selects */
+  ezLCD_touch_reset();
+
+  ezLCD_bench_touch(0x81);                    /* X = 170 */
+  ezLCD_bench_touch(170 & 0x7F);
+  ezLCD_bench_touch(170 >> 7);
+  ezLCD_bench_touch(0x82);                    /* Y = 100 */
+  ezLCD_bench_touch(100 & 0x7F);
+  ezLCD_bench_touch(100 >> 7);
+  ezLCD_bench_touch(0x83);
+
+  if(ezLCD_touch_poll(&touch) == EZLCD_TOUCH_DOWN)
+    key = ezLCD_hit_test(&keyboard, touch.x, touch.y);
+  ezLCD_touch_poll(&touch);
+  (void)key;
+}
+
+/* Redraws the knob of a horizontal slider */
+static void slider_knob(uint16_t x)
+{
+  ezLCD_set_color_rgb(EZLCD_WHITE);
+  ezLCD_set_xy(x, 100);
+  ezLCD_draw_rect_fill(x + 10, 120);
+}
+
+/* A finger sliding 150 pixels in 30 samples at 50 per second (20 ticks
+ * apart), redrawing the knob for every sample or only for each gesture */
+static void slider_drag(uint8_t coalesce)
+{
+  ezLCD_touch_t   touch;
+  ezLCD_gesture_t gesture;
+  uint8_t         i;
+
+  ezLCD_gesture_reset();
+  for(i = 0; i <= 30; ++i)
+  {
+    touch.kind = i == 0 ? EZLCD_TOUCH_DOWN : EZLCD_TOUCH_MOVE;
+    touch.x    = 50 + 5 * i;
+    touch.y    = 110;
+    if(ezLCD_gesture_feed(&touch, 20 * i, &gesture) == EZLCD_GESTURE_DRAG)
+    {
+      if(coalesce)
+        slider_knob(gesture.x);
+    }
+    if(!coalesce && i)
+      slider_knob(touch.x);
+  }
+  touch.kind = EZLCD_TOUCH_UP;
+  if(ezLCD_gesture_feed(&touch, 20 * i, &gesture) == EZLCD_GESTURE_DRAG &&
+     coalesce)
+    slider_knob(gesture.x);
+}
+
+static void slider_every_sample(void)
+{
+  slider_drag(0);
+}
+
+static void slider_coalesced(void)
+{
+  slider_drag(1);
+}
+
+/* A finger held on a slider knob for 20 samples with a pixel or two of
+ * jitter and one spike, redrawing the knob for every reported move */
+static void jitter_hold(uint8_t filter)
+{
+  static const int8_t jitter[] = {  1, -1,  2,  0, -2,  1, 30, -1,  0,  2,
+                                   -1,  1, -2,  0,  1, -1,  2, -2,  0,  1 };
+  ezLCD_touch_t touch;
+  uint8_t       i;
+
+  touch.kind = EZLCD_TOUCH_DOWN;
+  touch.x    = 100;
+  touch.y    = 110;
+  ezLCD_touch_filter(&touch);
+  for(i = 0; i < sizeof(jitter); ++i)
+  {
+    touch.kind = EZLCD_TOUCH_MOVE;
+    touch.x    = 100 + jitter[i];
+    touch.y    = 110 - jitter[(i + 7) % sizeof(jitter)] / 2;
+    if(filter && !ezLCD_touch_filter(&touch))
+      continue;
+    slider_knob(touch.x);
+  }
+}
+
+static void jitter_raw(void)
+{
+  jitter_hold(0);
+}
+
+static void jitter_filtered(void)
+{
+  jitter_hold(1);
+}
+
+const ezLCD_bench_case_t ezLCD_bench_scenarios[] =
+{
+  { "START page rebuild",           start_page           },
+  { "STOP page rebuild",            stop_page            },
+  { "START page display list",      start_page_replay    },
+  { "START page, batch buttons",    start_page_batch     },
+  { "START page, button page",      start_page_cached    },
+  { "STOP page, button page",       stop_page_cached     },
+  { "START page, back frame",       start_page_frame     },
+  { "STOP page, frame cache",       stop_page_frame      },
+  { "10 digits via putchar",        type_digits          },
+  { "10 digits, buffered putchar",  buffered_digits      },
+  { "10 digits via ezLCD_puts",     puts_digits          },
+  { "key press and echo",           key_press            },
+  { "key press, dispatch table",    key_press_dispatch   },
+  { "held key, DOWN repeated 5x",   repeated_press       },
+  { "key press during START page",  touch_during_redraw  },
+  { "calibratedXY tap, 40 keys",   calibrated_tap       },
+  { "slider drag, every sample",    slider_every_sample  },
+  { "slider drag, coalesced",       slider_coalesced     },
+  { "held finger, raw samples",     jitter_raw           },
+  { "held finger, filtered",        jitter_filtered      },
+  { "100 log lines, text box",      log_text_box         },
+  { "100 log lines, console",       log_console          },
+  { "100 log lines, console 10/rf", log_console_limit    },
+  { 0, 0 }
+};
+/** @} */ /* ezLCD_103_host_bench */
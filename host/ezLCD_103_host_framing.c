@@ -0,0 +1,133 @@
+/*
+ * @file   ezLCD_103_host_framing.c  <br>
+ * @author agent <br>
+ * @date   October 2026  <br>
+ * @brief  Checks that every command is sent under one chip select  <br>
+ * @defgroup ezLCD_103_host_framing Host Framing Check
+ * @{
+ *
+ * Sends commands longer than the staging buffer, a touch poll attempted in
+ * the middle of a command and a replayed display list, then prints one line
+ * per chip select transaction. The program is built twice, polled and with
+ * EZLCD_SPI_INTERRUPT, with global interrupts enabled so the emulated SPI
+ * interrupt is serviced; "make check" requires both to print the same
+ * transactions. Either build fails on its own if the reference renderer saw
+ * a command cut short by a chip select release.
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include <stdio.h>
+
+#include "ezLCD_103_driver.h"
+#include "ezLCD_103_host_render.h"
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+/* A 12 vertex polygon, 50 bytes in one command */
+static void polygon(void)
+{
+  uint16_t x[12];
+  uint16_t y[12];
+  uint8_t  i;
+
+  for(i = 0; i < 12; ++i)
+  {
+    x[i] = 100 + 10 * i;
+    y[i] = (i & 1) ? 50 : 90;
+  }
+  ezLCD_set_color_rgb(EZLCD_RED);
+  ezLCD_draw_polygon(12, x, y);
+}
+
+/* A touch poll due while a command is half sent must wait for its end */
+static void tick_inside_command(void)
+{
+  uint8_t i;
+
+  ezLCD_set_xy(10, 10);
+  ezLCD_cmd_put(0x2D);
+  for(i = 0; i < 20; ++i)
+  {
+    ezLCD_cmd_put('A' + i);
+    if(i == 17)
+      ezLCD_event_tick();
+  }
+  ezLCD_cmd_put(0x00);
+  ezLCD_cmd_flush();
+  ezLCD_event_tick();
+}
+
+static void replay(void)
+{
+  static uint8_t list[128];
+
+  ezLCD_display_list_begin(list, sizeof(list));
+  polygon();
+  ezLCD_puts("recorded in a display list");
+  if(ezLCD_display_list_end())
+    ezLCD_display_list_play(list);
+}
+
+static void print_log(void)
+{
+  uint32_t count;
+  uint32_t i;
+  const ezLCD_host_event_t *log = ezLCD_host_log(&count);
+
+  for(i = 0; i < count; ++i)
+  {
+    if(log[i].kind == EZLCD_HOST_SELECT)
+      fprintf(stdout, "CS");
+    else if(log[i].kind == EZLCD_HOST_DESELECT)
+      fprintf(stdout, "\n");
+    else
+      fprintf(stdout, " %02X", log[i].mosi);
+  }
+}
+
+int main(void)
+{
+  ezLCD_host_reset();
+  ezLCD_host_set_listener(ezLCD_render_listener);
+  ezLCD_render_reset();
+
+  EZLCD_INIT_SPI();
+  __enable_interrupt();
+
+  ezLCD_set_touch_protocol(ezButton);
+  polygon();
+  ezLCD_init_putchar(5, 5, 470, 100, 2, 2, 8, 13, EZLCD_WHITE, EZLCD_BLACK);
+  ezLCD_puts("a line of text longer than the staging buffer");
+  ezLCD_button_define_long(12,
+                           EZLCD_BUTTON_UP,
+                           START_BUTTON_EZLCD_BUTTON_UP_INDEX,
+                           START_BUTTON_EZLCD_BUTTON_DOWN_INDEX,
+                           START_BUTTON_DISABLED_INDEX,
+                           215,
+                           5,
+                           START_BUTTON_WIDTH,
+                           START_BUTTON_HEIGHT);
+  tick_inside_command();
+  replay();
+  ezLCD_spi_wait();
+
+  print_log();
+  fprintf(stdout, "%lu bytes in %lu transactions\n",
+          (unsigned long)ezLCD_host_bytes(),
+          (unsigned long)ezLCD_host_transactions());
+
+  if(ezLCD_render_abandoned() || ezLCD_render_unknown() ||
+     ezLCD_host_selected())
+  {
+    fprintf(stderr, "%lu commands cut short, %lu unknown opcodes%s\n",
+            (unsigned long)ezLCD_render_abandoned(),
+            (unsigned long)ezLCD_render_unknown(),
+            ezLCD_host_selected() ? ", display left selected" : "");
+    return 1;
+  }
+  return 0;
+}
+/** @} */ /* ezLCD_103_host_framing */
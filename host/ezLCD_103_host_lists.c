@@ -0,0 +1,118 @@
+/*
+ * @file   ezLCD_103_host_lists.c  <br>
+ * @author agent <br>
+ * @date   October 2026  <br>
+ * @brief  Checks the EZLCD_LIST_* macros against recorded display lists  <br>
+ * @defgroup ezLCD_103_host_lists Host Display List Check
+ * @{
+ *
+ * Writes a screen out as a constant table with every EZLCD_LIST_* macro,
+ * records the same screen made with the matching ezLCD_* calls and requires
+ * the two lists to be identical byte for byte. "make check" runs it, so a
+ * command whose encoding changes in the driver but not in its macro, or the
+ * other way round, fails the check.
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include <stdio.h>
+
+#include "ezLCD_103_driver.h"
+
+/*----------------------------------------------------------------------------*/
+/* CONSTANTS                                                                  */
+/*----------------------------------------------------------------------------*/
+#define START       12           /* Button ID, as in main.c */
+
+/*----------------------------------------------------------------------------*/
+/* VARIABLES                                                                  */
+/*----------------------------------------------------------------------------*/
+/* The screen, one macro of each kind */
+static const EZLCD_FLASH uint8_t table[] =
+{
+  EZLCD_LIST_DRAW_FRAME(1),
+  EZLCD_LIST_DEACTIVATE_ALL_BUTTONS(),
+  EZLCD_LIST_XY(0, 0),
+  EZLCD_LIST_PICTURE_ROM(BACKGROUND_1_INDEX),
+  EZLCD_LIST_COLOR(EZLCD_VIOLET),
+  EZLCD_LIST_XY(5, 5),
+  EZLCD_LIST_RECT_FILL(160, 65),
+  EZLCD_LIST_COLOR(EZLCD_WHITE),
+  EZLCD_LIST_RECT(165, 70),
+  EZLCD_LIST_BUTTON(START, EZLCD_BUTTON_UP,
+                    START_BUTTON_EZLCD_BUTTON_UP_INDEX,
+                    START_BUTTON_EZLCD_BUTTON_DOWN_INDEX,
+                    START_BUTTON_DISABLED_INDEX,
+                    215, 5, START_BUTTON_WIDTH, START_BUTTON_HEIGHT),
+  EZLCD_LIST_TRUE_TYPE_FONT(DEJAVUSANS_BOLD, 32, 32),
+  EZLCD_LIST_XY(300, 200),
+  EZLCD_LIST_CHAR('7'),
+  EZLCD_LIST_XY(7, 7),
+  EZLCD_LIST_STRING(5), 'l', 'i', 's', 't', 's', 0,
+  EZLCD_LIST_DISPLAY_FRAME(1),
+  EZLCD_LIST_END
+};
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+/* The same screen made with the driver's functions */
+static void screen(void)
+{
+  ezLCD_set_draw_frame(1);
+  ezLCD_deactivate_all_buttons();
+  ezLCD_set_xy(0, 0);
+  ezLCD_put_picture_rom(BACKGROUND_1_INDEX);
+  ezLCD_set_color_rgb(EZLCD_VIOLET);
+  ezLCD_set_xy(5, 5);
+  ezLCD_draw_rect_fill(160, 65);
+  ezLCD_set_color_rgb(EZLCD_WHITE);
+  ezLCD_draw_rect(165, 70);
+  ezLCD_button_define_long(START,
+                           EZLCD_BUTTON_UP,
+                           START_BUTTON_EZLCD_BUTTON_UP_INDEX,
+                           START_BUTTON_EZLCD_BUTTON_DOWN_INDEX,
+                           START_BUTTON_DISABLED_INDEX,
+                           215,
+                           5,
+                           START_BUTTON_WIDTH,
+                           START_BUTTON_HEIGHT);
+  ezLCD_set_true_type_font(DEJAVUSANS_BOLD, 32, 32);
+  ezLCD_set_xy(300, 200);
+  ezLCD_putchar('7');
+  ezLCD_puts("lists");              /* White text, as set up by main() */
+  ezLCD_set_display_frame(1);
+}
+
+int main(void)
+{
+  static uint8_t list[sizeof(table) + 16];
+  uint16_t length;
+  uint16_t i;
+
+  ezLCD_init_putchar(5, 5, 300, 200, 2, 2, 16, 16, EZLCD_BLACK, EZLCD_WHITE);
+  ezLCD_display_list_begin(list, sizeof(list));
+  screen();
+  length = ezLCD_display_list_end();
+
+  if(length != sizeof(table))
+  {
+    fprintf(stderr, "recorded %u bytes, the table has %u\n",
+            (unsigned)length, (unsigned)sizeof(table));
+    return 1;
+  }
+  for(i = 0; i < length; ++i)
+  {
+    if(list[i] != table[i])
+    {
+      fprintf(stderr, "byte %u: recorded %02X, the table has %02X\n",
+              (unsigned)i, list[i], table[i]);
+      return 1;
+    }
+  }
+
+  fprintf(stdout, "%u bytes, identical\n", (unsigned)length);
+  return 0;
+}
+/** @} */ /* ezLCD_103_host_lists */
@@ -0,0 +1,427 @@
+/*
+ * @file   ezLCD_103_host_render.c  <br>
+ * @author agent <br>
+ * @date   October 2026  <br>
+ * @brief  Host-side reference renderer for the ezLCD+103 command stream  <br>
+ * @defgroup ezLCD_103_host_render Host Reference Renderer
+ * @{
+ *
+ * This source interprets the command bytes sent to the display and paints
+ * them into software frames.
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ezLCD_103_common.h"
+#include "ezLCD_103_host_render.h"
+
+/*----------------------------------------------------------------------------*/
+/* CONSTANTS                                                                  */
+/*----------------------------------------------------------------------------*/
+#define LEN_UNKNOWN  -1   /* Opcode the renderer does not know */
+#define LEN_STRING   -2   /* Parameters end with a 0x00 byte */
+#define LEN_POLYGON  -3   /* First parameter gives the vertex count */
+
+#define PARAM_MAX    (1 + 4 * 255)   /* Largest polygon */
+#define PICTURE_MAX  1024            /* Picture sizes remembered */
+
+/*----------------------------------------------------------------------------*/
+/* VARIABLES                                                                  */
+/*----------------------------------------------------------------------------*/
+static uint8_t *frames[EZLCD_RENDER_FRAMES];
+
+static uint8_t  draw_frame;
+static uint8_t  display_frame;
+static uint8_t  color[3];
+static int16_t  pos_x;
+static int16_t  pos_y;
+static uint8_t  glyph_w = 8;
+static uint8_t  glyph_h = 13;
+
+static uint8_t  opcode;
+static uint8_t  in_command;
+static int16_t  expected;
+static uint16_t received;
+static uint8_t  params[PARAM_MAX];
+
+static uint16_t picture_w[PICTURE_MAX];
+static uint16_t picture_h[PICTURE_MAX];
+
+static int16_t  button_zone[64][4]; /* Corners of each defined button */
+
+static uint32_t pixel_count;
+static uint32_t command_count;
+static uint32_t unknown_count;
+static uint32_t abandoned_count;
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+/* Number of parameter bytes following each opcode the driver can send */
+static int16_t param_length(uint8_t code)
+{
+  switch(code)
+  {
+    case 0x00: case 0x21: case 0x22: case 0x23: case 0x26: case 0x5B:
+    case 0x83: case 0x9B: case 0xB3: case 0xB4: case 0xB6:
+      return 0;
+    case 0x20: case 0x2B: case 0x2C: case 0x35: case 0x36: case 0x3C:
+    case 0x51: case 0x52: case 0x80: case 0x81: case 0x82: case 0xB2:
+      return 1;
+    case 0x59: case 0x6E: case 0x6F: case 0x89: case 0x93: case 0x99:
+    case 0xA0: case 0xA1: case 0xB1:
+      return 2;
+    case 0x31: case 0x32: case 0x5A: case 0x91: case 0x9C:
+      return 3;
+    case 0x33: case 0x3E: case 0x3F: case 0x8A: case 0x8B: case 0xA4:
+    case 0xA5:
+      return 4;
+    case 0x5D: case 0x8F: case 0x90:
+      return 6;
+    case 0x5C: case 0x8C: case 0x8E:
+      return 8;
+    case 0xB5:
+      return 14;
+    case 0x2D: case 0x3D: case 0x70:
+      return LEN_STRING;
+    case 0xA6:
+      return LEN_POLYGON;
+    default:
+      return LEN_UNKNOWN;
+  }
+}
+
+static uint8_t *frame_pixels(uint8_t frame)
+{
+  if(frame >= EZLCD_RENDER_FRAMES) frame = 0;
+  if(!frames[frame])
+  {
+    frames[frame] = calloc(EZLCD_WIDTH * EZLCD_HEIGHT, 3);
+    if(!frames[frame]) abort();
+  }
+  return frames[frame];
+}
+
+static void plot(int32_t x, int32_t y)
+{
+  uint8_t *p;
+
+  if(x < 0 || y < 0 || x >= EZLCD_WIDTH || y >= EZLCD_HEIGHT) return;
+
+  p = frame_pixels(draw_frame) + 3 * (y * EZLCD_WIDTH + x);
+  p[0] = color[0];
+  p[1] = color[1];
+  p[2] = color[2];
+  ++pixel_count;
+}
+
+static void span(int32_t x1, int32_t x2, int32_t y)
+{
+  int32_t t;
+
+  if(x1 > x2) { t = x1; x1 = x2; x2 = t; }
+  if(y < 0 || y >= EZLCD_HEIGHT) return;
+  if(x1 < 0) x1 = 0;
+  if(x2 >= EZLCD_WIDTH) x2 = EZLCD_WIDTH - 1;
+  for(; x1 <= x2; ++x1) plot(x1, y);
+}
+
+static void line(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+  int32_t dx = abs(x2 - x1), sx = x1 < x2 ? 1 : -1;
+  int32_t dy = -abs(y2 - y1), sy = y1 < y2 ? 1 : -1;
+  int32_t err = dx + dy, e2;
+
+  for(;;)
+  {
+    plot(x1, y1);
+    if(x1 == x2 && y1 == y2) break;
+    e2 = 2 * err;
+    if(e2 >= dy) { err += dy; x1 += sx; }
+    if(e2 <= dx) { err += dx; y1 += sy; }
+  }
+}
+
+static void rect(int32_t x1, int32_t y1, int32_t x2, int32_t y2, uint8_t fill)
+{
+  int32_t t;
+
+  if(x1 > x2) { t = x1; x1 = x2; x2 = t; }
+  if(y1 > y2) { t = y1; y1 = y2; y2 = t; }
+
+  if(fill)
+  {
+    for(t = y1; t <= y2; ++t) span(x1, x2, t);
+    return;
+  }
+  span(x1, x2, y1);
+  if(y2 != y1) span(x1, x2, y2);
+  for(t = y1 + 1; t < y2; ++t)
+  {
+    plot(x1, t);
+    if(x2 != x1) plot(x2, t);
+  }
+}
+
+static void circle(int32_t cx, int32_t cy, int32_t r, uint8_t fill)
+{
+  int32_t x = r, y = 0, err = 1 - r;
+
+  while(x >= y)
+  {
+    if(fill)
+    {
+      span(cx - x, cx + x, cy + y);
+      if(y) span(cx - x, cx + x, cy - y);
+      if(x != y)
+      {
+        span(cx - y, cx + y, cy + x);
+        span(cx - y, cx + y, cy - x);
+      }
+    }
+    else
+    {
+      plot(cx + x, cy + y); plot(cx - x, cy + y);
+      plot(cx + x, cy - y); plot(cx - x, cy - y);
+      plot(cx + y, cy + x); plot(cx - y, cy + x);
+      plot(cx + y, cy - x); plot(cx - y, cy - x);
+    }
+    ++y;
+    if(err < 0) err += 2 * y + 1;
+    else { --x; err += 2 * (y - x) + 1; }
+  }
+}
+
+/* Even-odd scanline fill; the first vertex is the current position */
+static void polygon(void)
+{
+  int32_t vx[256], vy[256], xs[256];
+  uint16_t n = params[0] + 1;
+  uint16_t i, j, k, count;
+  int32_t y, ymin, ymax, t;
+
+  vx[0] = pos_x;
+  vy[0] = pos_y;
+  for(i = 1; i < n; ++i)
+  {
+    vx[i] = (int16_t)((params[4 * i - 3] << 8) | params[4 * i - 2]);
+    vy[i] = (int16_t)((params[4 * i - 1] << 8) | params[4 * i]);
+  }
+
+  ymin = ymax = vy[0];
+  for(i = 1; i < n; ++i)
+  {
+    if(vy[i] < ymin) ymin = vy[i];
+    if(vy[i] > ymax) ymax = vy[i];
+  }
+
+  for(y = ymin; y <= ymax; ++y)
+  {
+    count = 0;
+    for(i = 0, j = n - 1; i < n; j = i++)
+      if((vy[i] <= y && vy[j] > y) || (vy[j] <= y && vy[i] > y))
+        xs[count++] = vx[i] + (y - vy[i]) * (vx[j] - vx[i]) / (vy[j] - vy[i]);
+
+    for(i = 1; i < count; ++i)           /* Few crossings, insertion sort */
+      for(k = i; k > 0 && xs[k - 1] > xs[k]; --k)
+      { t = xs[k]; xs[k] = xs[k - 1]; xs[k - 1] = t; }
+
+    for(i = 0; i + 1 < count; i += 2) span(xs[i], xs[i + 1], y);
+  }
+}
+
+static void glyph(void)
+{
+  rect(pos_x, pos_y, pos_x + glyph_w - 1, pos_y + glyph_h - 1, 0);
+  pos_x += glyph_w;
+}
+
+static int16_t word(uint16_t offset)
+{
+  return (int16_t)((params[offset] << 8) | params[offset + 1]);
+}
+
+static void execute(void)
+{
+  uint32_t i;
+  uint8_t *p;
+
+  ++command_count;
+
+  switch(opcode)
+  {
+    case 0x21:                                   /* CLS */
+      p = frame_pixels(draw_frame);
+      for(i = 0; i < EZLCD_WIDTH * EZLCD_HEIGHT; ++i, p += 3)
+      {
+        p[0] = color[0];
+        p[1] = color[1];
+        p[2] = color[2];
+      }
+      pixel_count += EZLCD_WIDTH * EZLCD_HEIGHT;
+      break;
+    case 0x26: plot(pos_x, pos_y);                              break;
+    case 0x2B: glyph_w = 8; glyph_h = 13;                       break;
+    case 0x2C: case 0x3C: glyph();                              break;
+    case 0x2D: case 0x3D:
+      for(i = 0; i + 1 < received; ++i) glyph();
+      break;
+    case 0x31: memcpy(color, params, 3);                        break;
+    case 0x33: pos_x = word(0); pos_y = word(2);                break;
+    case 0x3E: pos_x = word(0); pos_y = word(2); plot(pos_x, pos_y); break;
+    case 0x3F:
+      line(pos_x, pos_y, word(0), word(2));
+      pos_x = word(0);
+      pos_y = word(2);
+      break;
+    case 0x51: draw_frame = params[0] % EZLCD_RENDER_FRAMES;    break;
+    case 0x52: display_frame = params[0] % EZLCD_RENDER_FRAMES; break;
+    case 0x59:
+      i = (uint16_t)word(0);
+      if(i < PICTURE_MAX && picture_w[i])
+        rect(pos_x, pos_y, pos_x + picture_w[i] - 1,
+             pos_y + picture_h[i] - 1, 0);
+      break;
+    case 0x6E: pos_x = word(0);                                 break;
+    case 0x6F: pos_y = word(0);                                 break;
+    case 0x89: circle(pos_x, pos_y, (uint16_t)word(0), 0);      break;
+    case 0x99: circle(pos_x, pos_y, (uint16_t)word(0), 1);      break;
+    case 0x91:
+      glyph_h = params[1];
+      glyph_w = params[2] ? params[2] : (params[1] + 1) / 2;
+      break;
+    case 0xA0: span(pos_x, word(0), pos_y);                     break;
+    case 0xA1: line(pos_x, pos_y, pos_x, word(0));              break;
+    case 0xA4: rect(pos_x, pos_y, word(0), word(2), 0);         break;
+    case 0xA5: rect(pos_x, pos_y, word(0), word(2), 1);         break;
+    case 0xA6: polygon();                                       break;
+    case 0xB5:                         /* Drawn in its initial state below */
+      button_zone[params[0] & 63][0] = word(8);
+      button_zone[params[0] & 63][1] = word(10);
+      button_zone[params[0] & 63][2] = word(8) + params[12] - 1;
+      button_zone[params[0] & 63][3] = word(10) + params[13] - 1;
+      /* Fall through */
+    case 0xB1:
+      if(params[1] != 4)                         /* Not invisible */
+        rect(button_zone[params[0] & 63][0], button_zone[params[0] & 63][1],
+             button_zone[params[0] & 63][2], button_zone[params[0] & 63][3],
+             0);
+      break;
+    default:                                     /* State only, not drawn */
+      break;
+  }
+}
+
+void ezLCD_render_reset(void)
+{
+  uint8_t i;
+
+  for(i = 0; i < EZLCD_RENDER_FRAMES; ++i)
+    if(frames[i]) memset(frames[i], 0, EZLCD_WIDTH * EZLCD_HEIGHT * 3);
+
+  draw_frame = display_frame = 0;
+  memset(color, 0, sizeof color);
+  pos_x = pos_y = 0;
+  glyph_w = 8;
+  glyph_h = 13;
+  in_command = 0;
+  pixel_count = command_count = unknown_count = abandoned_count = 0;
+}
+
+void ezLCD_render_byte(uint8_t data)
+{
+  if(!in_command)
+  {
+    opcode   = data;
+    expected = param_length(data);
+    received = 0;
+
+    if(expected == LEN_UNKNOWN) { ++unknown_count; return; }
+    if(expected == 0) { execute(); return; }
+    in_command = 1;
+    return;
+  }
+
+  if(received < PARAM_MAX) params[received] = data;
+  ++received;
+
+  if(expected == LEN_STRING)
+  {
+    if(data == 0x00) { in_command = 0; execute(); }
+    return;
+  }
+  if(expected == LEN_POLYGON)
+    expected = 1 + 4 * data;
+  if(received == expected)
+  {
+    in_command = 0;
+    execute();
+  }
+}
+
+void ezLCD_render_listener(const ezLCD_host_event_t *event)
+{
+  if(event->kind == EZLCD_HOST_BYTE)
+    ezLCD_render_byte(event->mosi);
+  else if(event->kind == EZLCD_HOST_DESELECT)
+  {
+    if(in_command)
+      ++abandoned_count;
+    in_command = 0;
+  }
+}
+
+uint32_t ezLCD_render_pixels(void)
+{
+  return pixel_count;
+}
+
+uint32_t ezLCD_render_commands(void)
+{
+  return command_count;
+}
+
+uint32_t ezLCD_render_unknown(void)
+{
+  return unknown_count;
+}
+
+uint32_t ezLCD_render_abandoned(void)
+{
+  return abandoned_count;
+}
+
+uint8_t ezLCD_render_display_frame(void)
+{
+  return display_frame;
+}
+
+const uint8_t *ezLCD_render_frame(uint8_t frame)
+{
+  return frame_pixels(frame);
+}
+
+void ezLCD_render_picture_size(uint16_t index, uint16_t width, uint16_t height)
+{
+  if(index >= PICTURE_MAX) return;
+  picture_w[index] = width;
+  picture_h[index] = height;
+}
+
+uint8_t ezLCD_render_write_ppm(const char *path, uint8_t frame)
+{
+  FILE *file = fopen(path, "wb");
+  uint8_t ok;
+
+  if(!file) return 0;
+  fprintf(file, "P6\n%d %d\n255\n", EZLCD_WIDTH, EZLCD_HEIGHT);
+  ok = fwrite(frame_pixels(frame), 3, EZLCD_WIDTH * EZLCD_HEIGHT, file)
+       == EZLCD_WIDTH * EZLCD_HEIGHT;
+  return (fclose(file) == 0) && ok;
+}
+/** @} */ /* ezLCD_103_host_render */
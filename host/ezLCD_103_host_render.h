@@ -0,0 +1,118 @@
+/**
+ * @file   ezLCD_103_host_render.h  <br>
+ * @author agent <br>
+ * @date   October 2026  <br>
+ * @brief  Host-side reference renderer for the ezLCD+103 command stream  <br>
+ * @defgroup ezLCD_103_host_render Host Reference Renderer
+ * @{
+ *
+ * This header describes a software model of the display which interprets the
+ * bytes the driver sends and paints them into EZLCD_WIDTH x EZLCD_HEIGHT RGB
+ * frames, one per display frame. It is fed either byte by byte with 
+ * ezLCD_render_byte() or by installing ezLCD_render_listener() as the SPI
+ * emulator's listener:
+ *
+ * @code
+   ezLCD_host_reset();
+   ezLCD_render_reset();
+   ezLCD_host_set_listener(ezLCD_render_listener);
+   ... driver calls ...
+   ezLCD_render_write_ppm("screen.ppm", ezLCD_render_display_frame());
+   @endcode
+ *
+ * Every command the driver can emit is parsed so the stream stays in step, 
+ * but only the following are drawn: CLS (0x21), SET_COLOR (0x31), SET_XY
+ * (0x33), SET_X/SET_Y (0x6E/0x6F), PLOT (0x26/0x3E), LINE (0x3F), H/V LINE
+ * (0xA0/0xA1), RECT (0xA4/0xA5), CIRCLE (0x89/0x99), POLYGON (0xA6), the
+ * frame commands (0x51/0x52) and the text commands (0x2C/0x3C/0x2D/0x3D).
+ *
+ * The renderer has no access to the fonts and bitmaps stored on the display,
+ * so glyphs are drawn as outlined cells of the current font size, buttons as
+ * outlined touch areas and ROM pictures as outlined boxes of the size given
+ * with ezLCD_render_picture_size() (pictures of unknown size paint nothing).
+ * Lines are always one pixel wide. The goal is to show where, and how much, a
+ * redraw paints rather than what it looks like.
+ */
+
+/* Used to prevent multiple inclusion of the header file */
+#ifndef EZLCD_HOST_RENDER_H
+#define EZLCD_HOST_RENDER_H
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include "ezLCD_103_common.h"
+
+/*----------------------------------------------------------------------------*/
+/* CONSTANTS                                                                  */
+/*----------------------------------------------------------------------------*/
+/** Number of frames modelled, as on the ezLCD+103 */
+#define EZLCD_RENDER_FRAMES 20
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+/** Clears every frame to black, resets the drawing state and counters. */
+void ezLCD_render_reset(void);
+
+/** Feeds one byte of the command stream to the renderer.
+ *
+ *  @par Parameters
+ *       - @a data = The byte sent on MOSI.
+ */
+void ezLCD_render_byte(uint8_t data);
+
+/** Feeds one SPI emulator log entry to the renderer. Its signature matches
+ *  ezLCD_host_listener_t so it may be installed directly. A chip select
+ *  release in the middle of a command abandons that command.
+ */
+void ezLCD_render_listener(const ezLCD_host_event_t *event);
+
+/** @returns The number of pixel writes since the last reset, counting a
+ *           pixel again each time it is overdrawn. */
+uint32_t ezLCD_render_pixels(void);
+
+/** @returns The number of commands interpreted since the last reset. */
+uint32_t ezLCD_render_commands(void);
+
+/** @returns The number of unknown opcodes seen since the last reset. */
+uint32_t ezLCD_render_unknown(void);
+
+/** @returns The number of commands cut short by a chip select release since
+ *           the last reset. Anything but 0 means the driver split a command
+ *           across transactions. */
+uint32_t ezLCD_render_abandoned(void);
+
+/** @returns The frame currently selected with SET_DISPLAY_FRAME (0x52). */
+uint8_t ezLCD_render_display_frame(void);
+
+/** Returns the pixels of a frame, EZLCD_WIDTH * EZLCD_HEIGHT RGB triplets
+ *  stored row by row from the top-left corner.
+ *
+ *  @par Parameters
+ *       - @a frame = Frame number in the set [0,19].
+ */
+const uint8_t *ezLCD_render_frame(uint8_t frame);
+
+/** Tells the renderer the size of a picture stored in the display's ROM so
+ *  PUT_PICTURE (0x59) can be accounted for.
+ *
+ *  @par Parameters
+ *       - @a index  = Picture index, as used by ezLCD_put_picture_rom().
+ *       - @a width  = Picture width in pixels.
+ *       - @a height = Picture height in pixels.
+ */
+void ezLCD_render_picture_size(uint16_t index, uint16_t width, uint16_t height);
+
+/** Writes a frame as a binary PPM (P6) image.
+ *
+ *  @par Parameters
+ *       - @a path  = File to create.
+ *       - @a frame = Frame number in the set [0,19].
+ *
+ *  @returns 1 on success, 0 if the file could not be written.
+ */
+uint8_t ezLCD_render_write_ppm(const char *path, uint8_t frame);
+
+#endif /* EZLCD_HOST_RENDER_H */
+/** @} */ /* ezLCD_103_host_render */
@@ -0,0 +1,278 @@
+/*
+ * @file   ezLCD_103_host_spi.c  <br>
+ * @author agent <br>
+ * @date   October 2026  <br>
+ * @brief  Host (Linux) port of the ezLCD+103 driver's SPI peripheral  <br>
+ * @defgroup ezLCD_103_host_spi Host SPI Emulator
+ * @{
+ *
+ * This source emulates the SPI master and chip select pin used by the driver.
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <string.h>
+
+#include "ezLCD_103_common.h"
+
+/*----------------------------------------------------------------------------*/
+/* CONSTANTS                                                                  */
+/*----------------------------------------------------------------------------*/
+/* Marks the received byte left in SPDR, see ezLCD_103_host_spi.h */
+#define RX_MARK 0x100
+
+/*----------------------------------------------------------------------------*/
+/* VARIABLES                                                                  */
+/*----------------------------------------------------------------------------*/
+/* Defined only when the driver is built with EZLCD_SPI_INTERRUPT */
+extern void ezLCD_spi_isr(void) __attribute__((weak));
+
+static volatile uint16_t spdr = RX_MARK;
+static volatile uint8_t  spsr;
+static volatile uint8_t  spcr;
+static volatile uint8_t  portb = (1 << EZLCD_SS_BAR_PIN);
+static volatile uint8_t  ddrb;
+
+static uint8_t  last_portb = (1 << EZLCD_SS_BAR_PIN); /* Port as last seen */
+static uint8_t  spsr_read;      /* SPSR was read while SPIF was set */
+static uint8_t  irq_enabled;    /* Emulated global interrupt flag */
+static uint8_t  in_isr;         /* ezLCD_spi_isr() is running */
+
+static uint8_t  *script;        /* Scripted MISO bytes */
+static uint32_t script_length;
+static uint32_t script_next;
+static ezLCD_host_responder_t responder;
+static ezLCD_host_listener_t  listener;
+
+static ezLCD_host_event_t *log_entries;
+static uint32_t log_length;
+static uint32_t log_capacity;
+static uint8_t  log_kept = 1;
+
+static uint32_t byte_count;
+static uint32_t transaction_count;
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+static void record(uint8_t kind, uint8_t mosi, uint8_t miso)
+{
+  ezLCD_host_event_t event;
+
+  event.kind = kind;
+  event.mosi = mosi;
+  event.miso = miso;
+
+  if(log_kept)
+  {
+    if(log_length == log_capacity)
+    {
+      log_capacity = log_capacity ? log_capacity * 2 : 1024;
+      log_entries  = realloc(log_entries, log_capacity * sizeof *log_entries);
+      if(!log_entries) abort();
+    }
+    log_entries[log_length++] = event;
+  }
+
+  if(listener) listener(&event);
+}
+
+static uint8_t next_miso(uint8_t mosi)
+{
+  if(script_next < script_length) return script[script_next++];
+  if(responder) return responder(mosi);
+  return 0x00;
+}
+
+/* Notices chip select edges made by writes to PORTB */
+static void sync_port(void)
+{
+  uint8_t changed = (portb ^ last_portb) & (1 << EZLCD_SS_BAR_PIN);
+
+  last_portb = portb;
+  if(!changed) return;
+
+  if(portb & (1 << EZLCD_SS_BAR_PIN))
+    record(EZLCD_HOST_DESELECT, 0, 0);
+  else
+  {
+    ++transaction_count;
+    record(EZLCD_HOST_SELECT, 0, 0);
+  }
+}
+
+/* Clocks out a byte written to SPDR and raises the interrupt if enabled */
+static void sync_spi(void)
+{
+  while(!(spdr & RX_MARK))
+  {
+    uint8_t mosi = spdr & 0xFF;
+    uint8_t miso = next_miso(mosi);
+
+    ++byte_count;
+    record(EZLCD_HOST_BYTE, mosi, miso);
+
+    spdr  = miso | RX_MARK;
+    spsr |= (1 << EZLCD_SPIF_BIT);
+    spsr_read = 0;
+
+    if((spcr & (1 << EZLCD_SPIE)) && irq_enabled && !in_isr && ezLCD_spi_isr)
+    {
+      in_isr = 1;
+      irq_enabled = 0;                       /* Entering a vector clears I */
+      spsr &= ~(1 << EZLCD_SPIF_BIT);        /* ...and SPIF */
+      ezLCD_spi_isr();
+      sync_port();
+      irq_enabled = 1;
+      in_isr = 0;
+    }
+  }
+}
+
+void ezLCD_host_sync(void)
+{
+  sync_port();
+  sync_spi();
+}
+
+volatile uint16_t *ezLCD_host_spdr(void)
+{
+  ezLCD_host_sync();
+
+  /* Reading SPSR with SPIF set and then accessing SPDR clears SPIF */
+  if(spsr_read)
+  {
+    spsr &= ~(1 << EZLCD_SPIF_BIT);
+    spsr_read = 0;
+  }
+  return &spdr;
+}
+
+volatile uint8_t *ezLCD_host_spsr(void)
+{
+  ezLCD_host_sync();
+  spsr_read = (spsr >> EZLCD_SPIF_BIT) & 1;
+  return &spsr;
+}
+
+volatile uint8_t *ezLCD_host_spcr(void)
+{
+  ezLCD_host_sync();
+  return &spcr;
+}
+
+volatile uint8_t *ezLCD_host_portb(void)
+{
+  ezLCD_host_sync();
+  return &portb;
+}
+
+volatile uint8_t *ezLCD_host_ddrb(void)
+{
+  ezLCD_host_sync();
+  return &ddrb;
+}
+
+uint8_t ezLCD_host_irq_state(void)
+{
+  return irq_enabled;
+}
+
+void ezLCD_host_irq_enable(uint8_t enable)
+{
+  ezLCD_host_sync();
+  irq_enabled = enable;
+
+  /* A transfer that completed while masked is serviced on unmasking */
+  if(enable && (spsr & (1 << EZLCD_SPIF_BIT)) && (spcr & (1 << EZLCD_SPIE))
+     && !in_isr && ezLCD_spi_isr)
+  {
+    in_isr = 1;
+    irq_enabled = 0;
+    spsr &= ~(1 << EZLCD_SPIF_BIT);
+    ezLCD_spi_isr();
+    irq_enabled = 1;
+    in_isr = 0;
+    ezLCD_host_sync();
+  }
+}
+
+void ezLCD_host_reset(void)
+{
+  spdr  = RX_MARK;
+  spsr  = 0;
+  spcr  = 0;
+  ddrb  = 0;
+  portb = last_portb = (1 << EZLCD_SS_BAR_PIN);
+  spsr_read   = 0;
+  irq_enabled = 0;
+
+  free(script);
+  script = 0;
+  script_length = script_next = 0;
+  responder = 0;
+  listener  = 0;
+
+  log_length = 0;
+  log_kept   = 1;
+  byte_count = 0;
+  transaction_count = 0;
+}
+
+void ezLCD_host_script_miso(const uint8_t *bytes, uint16_t length)
+{
+  uint32_t remaining = script_length - script_next;
+  uint8_t *grown = malloc(remaining + length + 1);
+
+  if(!grown) abort();
+  if(remaining) memcpy(grown, script + script_next, remaining);
+  memcpy(grown + remaining, bytes, length);
+
+  free(script);
+  script        = grown;
+  script_length = remaining + length;
+  script_next   = 0;
+}
+
+void ezLCD_host_set_responder(ezLCD_host_responder_t function)
+{
+  responder = function;
+}
+
+void ezLCD_host_set_listener(ezLCD_host_listener_t function)
+{
+  listener = function;
+}
+
+void ezLCD_host_keep_log(uint8_t keep)
+{
+  log_kept = keep;
+}
+
+const ezLCD_host_event_t *ezLCD_host_log(uint32_t *count)
+{
+  ezLCD_host_sync();
+  *count = log_length;
+  return log_entries;
+}
+
+uint32_t ezLCD_host_bytes(void)
+{
+  ezLCD_host_sync();
+  return byte_count;
+}
+
+uint32_t ezLCD_host_transactions(void)
+{
+  ezLCD_host_sync();
+  return transaction_count;
+}
+
+uint8_t ezLCD_host_selected(void)
+{
+  ezLCD_host_sync();
+  return !(portb & (1 << EZLCD_SS_BAR_PIN));
+}
+/** @} */ /* ezLCD_103_host_spi */
@@ -0,0 +1,176 @@
+/**
+ * @file   ezLCD_103_host_spi.h  <br>
+ * @author agent <br>
+ * @date   October 2026  <br>
+ * @brief  Host (Linux) port of the ezLCD+103 driver's SPI peripheral  <br>
+ * @defgroup ezLCD_103_host_spi Host SPI Emulator
+ * @{
+ *
+ * This header lets the unmodified driver sources in src/ be compiled and run
+ * on a PC. It is pulled in by ezLCD_103_user_config.h instead of the MCU's
+ * register header when EZLCD_HOST_PORT is defined (the host Makefile does
+ * this). 
+ *
+ * The AVR registers used by the driver (SPDR, SPSR, SPCR and PORTB) are
+ * mapped onto an emulated SPI master. Every byte clocked out on MOSI and every
+ * chip select edge on EZLCD_SS_BAR_PIN is recorded in a log, and the bytes
+ * returned on MISO come from a script supplied by the test bench. Transfers
+ * complete instantly, so SPIF is already set when the driver first polls it.
+ *
+ * Writes to a register cannot be trapped in C, so the emulator notices them
+ * on the next register access. SPDR is emulated as a 9-bit cell: the emulator
+ * always leaves the received byte in it with bit 8 set, which disappears when
+ * the driver stores it in a uint8_t. A value without bit 8 therefore means the
+ * driver wrote a new byte to send. Call ezLCD_host_sync() before inspecting
+ * the log so the final chip select release is accounted for.
+ *
+ * The SPI transfer complete interrupt is emulated too. When SPIE is set in
+ * SPCR and interrupts are enabled, ezLCD_spi_isr() is called right after each
+ * byte, exactly as the MCU would.
+ */
+
+/* Used to prevent multiple inclusion of the header file */
+#ifndef EZLCD_HOST_SPI_H
+#define EZLCD_HOST_SPI_H
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include <stdint.h>
+
+/*----------------------------------------------------------------------------*/
+/* REGISTERS                                                                  */
+/*----------------------------------------------------------------------------*/
+/** Tells ezLCD_103_common.h that the fixed-width integer types exist */
+#define EZLCD_HAVE_STDINT
+
+/** Emulated SPI Data Register */
+#define SPDR  (*ezLCD_host_spdr())
+/** Emulated SPI Status Register */
+#define SPSR  (*ezLCD_host_spsr())
+/** Emulated SPI Control Register */
+#define SPCR  (*ezLCD_host_spcr())
+/** Emulated port holding the SPI pins */
+#define PORTB (*ezLCD_host_portb())
+/** Emulated data direction register for PORTB */
+#define DDRB  (*ezLCD_host_ddrb())
+
+/*----------------------------------------------------------------------------*/
+/* INTRINSICS                                                                 */
+/*----------------------------------------------------------------------------*/
+/** Emulated global interrupt state, see EZLCD_CRITICAL_ENTER() */
+#define __save_interrupt()       ezLCD_host_irq_state()
+/** Emulated global interrupt disable */
+#define __disable_interrupt()    ezLCD_host_irq_enable(0)
+/** Emulated global interrupt enable */
+#define __enable_interrupt()     ezLCD_host_irq_enable(1)
+/** Emulated global interrupt restore */
+#define __restore_interrupt(s)   ezLCD_host_irq_enable(s)
+/** Time does not need to pass on the host */
+#define __delay_cycles(n)
+
+/** On the host the SPI interrupt handler is a plain function */
+#define EZLCD_SPI_ISR()          void ezLCD_spi_isr(void)
+/** On the host the touch timer handler is a plain function too */
+#define EZLCD_TOUCH_TIMER_ISR()  void ezLCD_touch_timer_isr(void)
+/** On the host flash tables are ordinary constants */
+#define EZLCD_FLASH
+
+/*----------------------------------------------------------------------------*/
+/* TYPEDEFS                                                                   */
+/*----------------------------------------------------------------------------*/
+/** Kinds of entries in the bus log */
+typedef enum { EZLCD_HOST_BYTE = 0,  /**< One byte exchanged on MOSI/MISO */
+               EZLCD_HOST_SELECT,    /**< Chip select asserted (pin low) */
+               EZLCD_HOST_DESELECT   /**< Chip select released (pin high) */
+             } ezLCD_host_kind_t;
+
+/** One entry in the bus log */
+typedef struct
+{
+  uint8_t kind;  /**< An ezLCD_host_kind_t */
+  uint8_t mosi;  /**< Byte sent by the driver (EZLCD_HOST_BYTE only) */
+  uint8_t miso;  /**< Byte returned to the driver (EZLCD_HOST_BYTE only) */
+} ezLCD_host_event_t;
+
+/** Optional function called for every log entry as it happens */
+typedef void (*ezLCD_host_listener_t)(const ezLCD_host_event_t *event);
+
+/** Optional function that produces a MISO byte once the script runs out */
+typedef uint8_t (*ezLCD_host_responder_t)(uint8_t mosi);
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+/** Register accessors used by the macros above. Not to be called directly. */
+volatile uint16_t *ezLCD_host_spdr(void);
+/** @copydoc ezLCD_host_spdr() */
+volatile uint8_t  *ezLCD_host_spsr(void);
+/** @copydoc ezLCD_host_spdr() */
+volatile uint8_t  *ezLCD_host_spcr(void);
+/** @copydoc ezLCD_host_spdr() */
+volatile uint8_t  *ezLCD_host_portb(void);
+/** @copydoc ezLCD_host_spdr() */
+volatile uint8_t  *ezLCD_host_ddrb(void);
+/** Emulated interrupt flag accessors used by the intrinsics above. */
+uint8_t ezLCD_host_irq_state(void);
+/** @copydoc ezLCD_host_irq_state() */
+void    ezLCD_host_irq_enable(uint8_t enable);
+
+/** Clears the log, the MISO script and all registers. The chip select pin
+ *  starts high (display deselected) and interrupts start disabled.
+ */
+void ezLCD_host_reset(void);
+
+/** Brings the emulator up to date with any register write the driver has
+ *  made since its last register access.
+ */
+void ezLCD_host_sync(void);
+
+/** Appends bytes to the MISO script. Each byte the driver clocks out consumes
+ *  one scripted byte; once the script is empty the responder (if any) is
+ *  asked, and otherwise 0x00 is returned.
+ *
+ *  @par Parameters
+ *       - @a bytes  = Bytes the display should answer with, in order.
+ *       - @a length = Number of bytes.
+ */
+void ezLCD_host_script_miso(const uint8_t *bytes, uint16_t length);
+
+/** Installs a function that answers MISO bytes once the script is empty.
+ *  Pass 0 to remove it.
+ */
+void ezLCD_host_set_responder(ezLCD_host_responder_t responder);
+
+/** Installs a function which is called for every log entry. Pass 0 to 
+ *  remove it.
+ */
+void ezLCD_host_set_listener(ezLCD_host_listener_t listener);
+
+/** Enables or disables keeping the log in memory. It is enabled after
+ *  ezLCD_host_reset(); long benchmarks may turn it off and rely on the
+ *  counters and listener instead.
+ */
+void ezLCD_host_keep_log(uint8_t keep);
+
+/** Returns the bus log.
+ *
+ *  @par Parameters
+ *       - @a count = Receives the number of entries.
+ *
+ *  @returns A pointer to the first entry, valid until the next call into
+ *           the emulator.
+ */
+const ezLCD_host_event_t *ezLCD_host_log(uint32_t *count);
+
+/** @returns The number of bytes clocked out since ezLCD_host_reset(). */
+uint32_t ezLCD_host_bytes(void);
+
+/** @returns The number of chip select assertions since ezLCD_host_reset(). */
+uint32_t ezLCD_host_transactions(void);
+
+/** @returns 1 if the display is currently selected, 0 otherwise. */
+uint8_t ezLCD_host_selected(void);
+
+#endif /* EZLCD_HOST_SPI_H */
+/** @} */ /* ezLCD_103_host_spi */
@@ -0,0 +1,119 @@
+/*
+ * @file   ezLCD_103_host_touch.c  <br>
+ * @author agent <br>
+ * @date   October 2026  <br>
+ * @brief  Checks that calibratedXY reports survive drawing commands  <br>
+ * @defgroup ezLCD_103_host_touch Host Touch Check
+ * @{
+ *
+ * The display answers every byte it receives, so a touch report may come
+ * back while a drawing command is being sent rather than during
+ * ezLCD_touch_poll(). The check scripts a pen down, then lets a pen up
+ * arrive behind a rectangle, a report split between a move and the poll and
+ * another pen up behind a polygon, and requires ezLCD_touch_poll() to return
+ * each of them in order. Like the framing check it is built polled and with
+ * EZLCD_SPI_INTERRUPT, and "make check" runs both.
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include <stdio.h>
+
+#include "ezLCD_103_driver.h"
+
+/*----------------------------------------------------------------------------*/
+/* VARIABLES                                                                  */
+/*----------------------------------------------------------------------------*/
+static uint8_t failed;
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+/* Scripts an X and Y report, as the display encodes it */
+static void script_xy(uint16_t x, uint16_t y)
+{
+  uint8_t report[6];
+
+  report[0] = 0x81;
+  report[1] = x & 0x7F;
+  report[2] = x >> 7;
+  report[3] = 0x82;
+  report[4] = y & 0x7F;
+  report[5] = y >> 7;
+  ezLCD_host_script_miso(report, sizeof(report));
+}
+
+static void script_up(void)
+{
+  static const uint8_t up = 0x83;
+
+  ezLCD_host_script_miso(&up, 1);
+}
+
+/* A 6 vertex polygon */
+static void polygon(void)
+{
+  static uint16_t x[6] = {100, 120, 140, 160, 180, 200};
+  static uint16_t y[6] = { 50,  90,  50,  90,  50,  90};
+
+  ezLCD_draw_polygon(6, x, y);
+}
+
+static void expect(const char *step, ezLCD_touch_kind_t kind,
+                   uint16_t x, uint16_t y)
+{
+  ezLCD_touch_t touch;
+  ezLCD_touch_kind_t got = ezLCD_touch_poll(&touch);
+
+  if(got != kind || (kind != EZLCD_TOUCH_NONE &&
+                     (touch.x != x || touch.y != y)))
+  {
+    fprintf(stderr, "%s: expected %u at %u,%u, got %u at %u,%u\n",
+            step, (unsigned)kind, (unsigned)x, (unsigned)y,
+            (unsigned)got, (unsigned)touch.x, (unsigned)touch.y);
+    failed = 1;
+  }
+}
+
+int main(void)
+{
+  ezLCD_host_reset();
+  EZLCD_INIT_SPI();
+  __enable_interrupt();
+
+  ezLCD_set_touch_protocol(calibratedXY);
+  ezLCD_touch_reset();
+  ezLCD_spi_wait();
+
+  /* Pen down, read by the poll itself */
+  script_xy(170, 100);
+  expect("pen down", EZLCD_TOUCH_DOWN, 170, 100);
+
+  /* Pen up, clocked in while a rectangle is drawn */
+  script_up();
+  ezLCD_set_xy(5, 5);
+  ezLCD_draw_rect_fill(160, 65);
+  expect("pen up behind a draw", EZLCD_TOUCH_UP, 170, 100);
+  expect("idle", EZLCD_TOUCH_NONE, 0, 0);
+
+  /* The next report, 5 bytes behind a move and the last read by the poll */
+  script_xy(300, 200);
+  ezLCD_set_xy(100, 50);
+  expect("split pen down", EZLCD_TOUCH_DOWN, 300, 200);
+
+  /* Pen up behind a polygon */
+  script_up();
+  polygon();
+  expect("pen up behind a polygon", EZLCD_TOUCH_UP, 300, 200);
+
+  if(ezLCD_host_selected())
+  {
+    fprintf(stderr, "display left selected\n");
+    failed = 1;
+  }
+  if(!failed)
+    fprintf(stdout, "pen up behind a draw command kept\n");
+  return failed;
+}
+/** @} */ /* ezLCD_103_host_touch */
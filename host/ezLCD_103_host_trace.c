@@ -0,0 +1,100 @@
+/*
+ * @file   ezLCD_103_host_trace.c  <br>
+ * @author agent <br>
+ * @date   October 2026  <br>
+ * @brief  Prints the SPI traffic of the example start-up screen  <br>
+ * @defgroup ezLCD_103_host_trace Host Bus Trace
+ * @{
+ *
+ * Runs the start-up sequence of main.c against the emulated SPI peripheral
+ * and prints one line per chip select transaction, followed by the totals.
+ * The display's answers are scripted so that ezLCD_ping() succeeds. When a
+ * file name is given, the rendered display frame is written to it as a PPM
+ * image.
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include <stdio.h>
+
+#include "ezLCD_103_driver.h"
+#include "ezLCD_103_host_render.h"
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+/* Answers the PING command (0x83) the way the display does */
+static uint8_t display_responder(uint8_t mosi)
+{
+  static uint8_t last;
+  uint8_t miso = (last == 0x83) ? 0x38 : 0x00;
+
+  last = mosi;
+  return miso;
+}
+
+static void print_log(void)
+{
+  uint32_t count;
+  uint32_t i;
+  const ezLCD_host_event_t *log = ezLCD_host_log(&count);
+
+  for(i = 0; i < count; ++i)
+  {
+    if(log[i].kind == EZLCD_HOST_SELECT)
+      fprintf(stdout, "CS");
+    else if(log[i].kind == EZLCD_HOST_DESELECT)
+      fprintf(stdout, "\n");
+    else
+      fprintf(stdout, " %02X", log[i].mosi);
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  ezLCD_host_reset();
+  ezLCD_host_set_responder(display_responder);
+  ezLCD_host_set_listener(ezLCD_render_listener);
+  ezLCD_render_reset();
+  ezLCD_render_picture_size(BACKGROUND_1_INDEX,
+                            BACKGROUND_1_WIDTH, BACKGROUND_1_HEIGHT);
+
+  EZLCD_INIT_SPI();
+
+  while(!ezLCD_ping());
+
+  ezLCD_clear();
+  ezLCD_put_picture_rom(BACKGROUND_1_INDEX);
+  ezLCD_set_touch_protocol(ezButton);
+  ezLCD_button_define_long(12,
+                           EZLCD_BUTTON_UP,
+                           START_BUTTON_EZLCD_BUTTON_UP_INDEX,
+                           START_BUTTON_EZLCD_BUTTON_DOWN_INDEX,
+                           START_BUTTON_DISABLED_INDEX,
+                           215,
+                           5,
+                           START_BUTTON_WIDTH,
+                           START_BUTTON_HEIGHT);
+  ezLCD_init_putchar(5, 5, 165-5, 70-5, 2, 2, 32,32,EZLCD_WHITE,EZLCD_VIOLET);
+  ezLCD_set_true_type_font(DEJAVUSANS_BOLD,32,32);
+  ezLCD_set_xy(7, 7);
+  ezLCD_putchar('7');
+
+  print_log();
+  fprintf(stdout, "%lu bytes in %lu transactions\n",
+          (unsigned long)ezLCD_host_bytes(),
+          (unsigned long)ezLCD_host_transactions());
+  fprintf(stdout, "%lu pixels painted by %lu commands\n",
+          (unsigned long)ezLCD_render_pixels(),
+          (unsigned long)ezLCD_render_commands());
+
+  if(argc > 1 &&
+     !ezLCD_render_write_ppm(argv[1], ezLCD_render_display_frame()))
+  {
+    fprintf(stderr, "cannot write %s\n", argv[1]);
+    return 1;
+  }
+  return 0;
+}
+/** @} */ /* ezLCD_103_host_trace */
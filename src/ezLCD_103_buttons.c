@@ -18,9 +18,149 @@
 #include "ezLCD_103_common.h"
 #include "ezLCD_103_buttons.h"
 
+/*----------------------------------------------------------------------------*/
+/* CONSTANTS                                                                  */
+/*----------------------------------------------------------------------------*/
+#define NO_BUTTON   0xFF        /* No button is held */
+#define BUTTON_STATE  0x07      /* Nibble bits holding the button state */
+#define BUTTON_CACHED 0x08      /* Nibble bit: definition in button_cache */
+#define BUTTON_PARAMS 12        /* 0xB5 parameter bytes after the state */
+
+/*----------------------------------------------------------------------------*/
+/* VARIABLES                                                                  */
+/*----------------------------------------------------------------------------*/
+static uint16_t suppressed;     /* 0xB1 commands not sent, see below */
+
+/* Definitions (0xB5 parameters after the state) of the first buttons, valid
+ * where their nibble in ezLCD_state has BUTTON_CACHED set */
+static uint8_t  button_cache[EZLCD_BUTTON_CACHE_IDS][BUTTON_PARAMS];
+
+static uint16_t poll_fast = EZLCD_POLL_FAST;  /* Interval after activity */
+static uint16_t poll_slow = EZLCD_POLL_SLOW;  /* Interval when idle */
+static uint16_t poll_idle;                    /* Polls that found nothing */
+static uint16_t poll_active;                  /* Polls that found an event */
+
+static ezLCD_button_handlers_t *handlers;     /* Table in use, may be 0 */
+static uint8_t  held_id = NO_BUTTON;          /* Button pressed, not released */
+static uint16_t held_since;                   /* Clock when it was pressed */
+static uint8_t  held_long;                    /* Its long press was dispatched */
+
 /*----------------------------------------------------------------------------*/
 /* FUNCTIONS                                                                  */
 /*----------------------------------------------------------------------------*/
+/* Returns the nibble of button @a id in the table in ezLCD_state, 0 if
+ * unknown */
+static uint8_t ezLCD_button_nibble(uint8_t id)
+{
+ uint8_t states;
+ 
+ if(!(ezLCD_state.valid & EZLCD_STATE_BUTTONS))
+   return 0;
+ 
+ states = ezLCD_state.buttons[id >> 1];
+ return (id & 1) ? states >> 4 : states & 0x0F;
+}
+
+/* Sets the nibble of button @a id. The table starts over, all unknown,
+ * whenever the shadow is invalidated. */
+static void ezLCD_button_nibble_set(uint8_t id, uint8_t nibble)
+{
+ uint8_t i;
+ uint8_t *p = &ezLCD_state.buttons[id >> 1];
+ 
+ if(!(ezLCD_state.valid & EZLCD_STATE_BUTTONS))
+ {
+   for(i = 0; i < sizeof(ezLCD_state.buttons); ++i)
+     ezLCD_state.buttons[i] = 0;
+   ezLCD_state.valid |= EZLCD_STATE_BUTTONS;
+ }
+ 
+ if(id & 1)
+   *p = (*p & 0x0F) | (nibble << 4);
+ else
+   *p = (*p & 0xF0) | nibble;
+}
+
+/* Records the state the display now shows for button @a id */
+static void ezLCD_button_remember(uint8_t id, uint8_t state)
+{
+ ezLCD_button_nibble_set(id, (ezLCD_button_nibble(id) & BUTTON_CACHED) | state);
+}
+
+/* Returns the state the display shows for button @a id, 0 if unknown */
+static uint8_t ezLCD_button_recall(uint8_t id)
+{
+ return ezLCD_button_nibble(id) & BUTTON_STATE;
+}
+
+/* Encodes the 0xB5 parameters of @a button which follow its state */
+static void ezLCD_button_params(const ezLCD_button_t *button, uint8_t *params)
+{
+ params[0]  = button->index_up >> 8;
+ params[1]  = button->index_up;
+ params[2]  = button->index_down >> 8;
+ params[3]  = button->index_down;
+ params[4]  = button->index_disabled >> 8;
+ params[5]  = button->index_disabled;
+ params[6]  = button->x >> 8;
+ params[7]  = button->x;
+ params[8]  = button->y >> 8;
+ params[9]  = button->y;
+ params[10] = button->width;
+ params[11] = button->height;
+}
+
+/* Returns 1 if the display is known to hold exactly this definition for
+ * button @a id, whatever its state */
+static uint8_t ezLCD_button_is_live(uint8_t id, const uint8_t *params)
+{
+ uint8_t i;
+ 
+ if(id >= EZLCD_BUTTON_CACHE_IDS || !(ezLCD_button_nibble(id) & BUTTON_CACHED))
+   return 0;
+ 
+ for(i = 0; i < BUTTON_PARAMS; ++i)
+   if(button_cache[id][i] != params[i])
+     return 0;
+ 
+ return 1;
+}
+
+/* Stages one button definition (0xB5) without ending the transaction, and
+ * records it as live */
+static void ezLCD_button_put(const ezLCD_button_t *button)
+{
+ uint8_t params[BUTTON_PARAMS];
+ uint8_t i;
+ 
+ ezLCD_button_params(button, params);
+ 
+ ezLCD_cmd_put(0xB5);
+ ezLCD_cmd_put(button->id);
+ ezLCD_cmd_put(button->state);
+ for(i = 0; i < BUTTON_PARAMS; ++i)
+   ezLCD_cmd_put(params[i]);
+ 
+ if(button->id < EZLCD_BUTTON_CACHE_IDS)
+ {
+   for(i = 0; i < BUTTON_PARAMS; ++i)
+     button_cache[button->id][i] = params[i];
+   ezLCD_button_nibble_set(button->id, BUTTON_CACHED | button->state);
+ }
+ else
+   ezLCD_button_nibble_set(button->id, button->state);
+}
+
+/* Stages a state change (0xB1) without ending the transaction */
+static void ezLCD_button_put_state(uint8_t id, uint8_t state)
+{
+ ezLCD_button_remember(id, state);
+ 
+ ezLCD_cmd_put(0xB1);
+ ezLCD_cmd_put(id);
+ ezLCD_cmd_put(state);
+}
+
 void ezLCD_button_define_long(uint8_t id,
                               ezLCD_button_state_t state, 
                               uint16_t index_up,
@@ -32,103 +172,310 @@ void ezLCD_button_define_long(uint8_t id,
                               uint8_t height)
 
 {
+ ezLCD_button_t button;
+ 
  if(id > 63) return;
  
- ezLCD_transfer_data_long(0xB5,0);
- ezLCD_transfer_data_long(id,0);
- ezLCD_transfer_data_long(state,0);
+ button.id             = id;
+ button.state          = state;
+ button.index_up       = index_up;
+ button.index_down     = index_down;
+ button.index_disabled = index_disabled;
+ button.x              = x;
+ button.y              = y;
+ button.width          = width;
+ button.height         = height;
  
- ezLCD_transfer_data_long(index_up >> 8,0);
- ezLCD_transfer_data_long(index_up & 0xFF,0);
+ ezLCD_button_put(&button);
+ ezLCD_cmd_flush();
+}
+
+void ezLCD_button_define_batch(const ezLCD_button_t *buttons, uint8_t count)
+{
+ for(; count != 0; --count, ++buttons)
+ {
+   if(buttons->id <= 63)
+     ezLCD_button_put(buttons);
+ }
+ 
+ ezLCD_cmd_flush();
+}
+
+void ezLCD_button_page(const EZLCD_FLASH ezLCD_button_t *buttons,
+                       uint8_t count,
+                       uint8_t repaint)
+{
+ ezLCD_button_t button;
+ uint8_t params[BUTTON_PARAMS];
+ uint8_t on_page[8];
+ uint8_t state;
+ uint8_t id;
  
- ezLCD_transfer_data_long(index_down >> 8,0);
- ezLCD_transfer_data_long(index_down & 0xFF,0);
+ /* Nothing is known about the buttons the display holds, so none of them
+  * can be reused or hidden one by one: start from none */
+ if(!(ezLCD_state.valid & EZLCD_STATE_BUTTONS))
+ {
+   ezLCD_cmd_put(0xB4);
+   for(id = 0; id < sizeof(ezLCD_state.buttons); ++id)
+     ezLCD_state.buttons[id] = 0;
+   ezLCD_state.valid |= EZLCD_STATE_BUTTONS;
+ }
  
- ezLCD_transfer_data_long(index_disabled >> 8,0);
- ezLCD_transfer_data_long(index_disabled & 0xFF,0);
+ for(id = 0; id < sizeof(on_page); ++id)
+   on_page[id] = 0;
  
- ezLCD_transfer_data_long(x >> 8,0);
- ezLCD_transfer_data_long(x & 0xFF,0);
+ for(; count != 0; --count, ++buttons)
+ {
+   button = *buttons;
+   if(button.id > 63)
+     continue;
+   on_page[button.id >> 3] |= 1 << (button.id & 7);
+   
+   ezLCD_button_params(&button, params);
+   if(!ezLCD_button_is_live(button.id, params))
+     ezLCD_button_put(&button);
+   else if(repaint || ezLCD_button_recall(button.id) != button.state)
+     ezLCD_button_put_state(button.id, button.state);
+ }
  
- ezLCD_transfer_data_long(y >> 8,0);
- ezLCD_transfer_data_long(y & 0xFF,0);
+ /* Hide the buttons of the previous page which this one does not use */
+ for(id = 0; id <= 63; ++id)
+ {
+   state = ezLCD_button_recall(id);
+   if(state && state != EZLCD_BUTTON_INVISIBLE &&
+      !(on_page[id >> 3] & (1 << (id & 7))))
+     ezLCD_button_put_state(id, EZLCD_BUTTON_INVISIBLE);
+ }
  
- ezLCD_transfer_data_long(width,0);
- ezLCD_transfer_data_long(height,1);
+ ezLCD_cmd_flush();
 }
 
-
 void ezLCD_set_touch_protocol(ezLCD_touch_protocol_t protocol)
 {
- ezLCD_transfer_data_long(0xB2,0);
- ezLCD_transfer_data_long(protocol,1);
+ ezLCD_event_harvest(EZLCD_HARVEST_OFF);
+ 
+ ezLCD_cmd_put(0xB2);
+ ezLCD_cmd_put(protocol);
+ ezLCD_cmd_flush();
+ 
+ /* cuButton packets cannot be told apart from the other traffic */
+ if(protocol == ezButton)
+   ezLCD_event_harvest(EZLCD_HARVEST_BUTTONS);
+ else if(protocol == calibratedXY)
+   ezLCD_event_harvest(EZLCD_HARVEST_TOUCH);
 }
 
 void ezLCD_set_button_state(uint8_t id, ezLCD_button_state_t state)
 {
- ezLCD_transfer_data_long(0xB1,0);
- ezLCD_transfer_data_long(id,0);
- ezLCD_transfer_data_long(state,1);
+ if(id > 63) return;
+ 
+ /* The display already shows this state, e.g. a repeated DOWN packet */
+ if(ezLCD_button_recall(id) == state)
+ {
+   ++suppressed;
+   return;
+ }
+ ezLCD_button_put_state(id, state);
+ ezLCD_cmd_flush();
 }
 
 void ezLCD_calibrate_screen()
 {
   uint8_t finished = 0;
   
+  ezLCD_bus_claim();                 /* The reply must not go to a touch poll */
   ezLCD_transfer_data(0xB6);
   
   do
   {
     finished = ezLCD_transfer_data(0x00);
   } while(finished != 0x32);
+  ezLCD_bus_release();
+  
+  /* Calibration draws on the screen and changes the font, forget it all */
+  ezLCD_state_invalidate();
 }
 
 void ezLCD_all_buttons_up()
 {
-  ezLCD_transfer_data(0xB3);
+  uint8_t id;
+  
+  ezLCD_cmd_put(0xB3);
+  ezLCD_cmd_flush();
+  
+  /* Every button the display has is UP now; unknown ones stay unknown and
+   * the definitions cached keep their BUTTON_CACHED bit */
+  for(id = 0; id < 64; ++id)
+    if(ezLCD_button_recall(id))
+      ezLCD_button_remember(id, EZLCD_BUTTON_UP);
 }
 
 //buttons stop responding to touch, does not remove from screen.
 void ezLCD_deactivate_all_buttons()
 {
-  ezLCD_transfer_data(0xB4);
+  ezLCD_cmd_put(0xB4);
+  ezLCD_cmd_flush();
+  
+  ezLCD_state.valid &= ~EZLCD_STATE_BUTTONS;
+}
+
+uint16_t ezLCD_button_suppressed(void)
+{
+  return suppressed;
+}
+
+void ezLCD_button_suppressed_reset(void)
+{
+  suppressed = 0;
 }
 
 uint8_t ezLCD_wait_for_event()
 {
-  uint8_t released = 0; /* Button Released flag */
+  uint8_t button;
+  uint16_t interval = poll_fast;
+  ezLCD_event_t event;
   
-  int8_t button = -1;   /* Button ID can NEVER be negative, but it can be zero
-                         * so we initialize it to -1 to indicate that no button 
-                         * has been pressed yet. */  
+  /* Loop until a button has been released. Presses along the way are only
+   * used to paint the EZLCD_BUTTON_DOWN image. */
+  while((event = ezLCD_poll_event(&button)) != EZLCD_EVENT_RELEASE)
+  {
+    if(event == EZLCD_EVENT_NONE)
+    {
+      /* Nothing happening, back off towards the slow rate */
+      EZLCD_POLL_IDLE(interval);
+      interval = (interval > poll_slow / 2) ? poll_slow : interval * 2;
+    }
+    else
+      interval = poll_fast;
+  }
+  
+  return button;
+}
+
+void ezLCD_set_poll_policy(uint16_t fast, uint16_t slow)
+{
+  /* Doubling 0 would keep polling flat out */
+  if(fast == 0)
+    fast = 1;
+  if(slow < fast)
+    slow = fast;
   
+  poll_fast = fast;
+  poll_slow = slow;
+}
+
+uint16_t ezLCD_poll_idle_count(void)
+{
+  return poll_idle;
+}
+
+uint16_t ezLCD_poll_active_count(void)
+{
+  return poll_active;
+}
+
+void ezLCD_poll_count_reset(void)
+{
+  poll_idle   = 0;
+  poll_active = 0;
+}
+
+ezLCD_event_t ezLCD_poll_event(uint8_t *id)
+{
+  ezLCD_touch_event_t event;
+  uint8_t button;
   
-  /* Loop until the button has been released */
-  while(button == -1 || released == 0)
-  { 
-    /* Send nop command to display, we only care about the data being sent back
-    from the ezLCD.*/
+  /* Packets that came back while commands were being sent are handled first,
+   * in the order they arrived. */
+  ezLCD_spi_wait();
+  if(ezLCD_event_get(&event))
+    button = event.packet;
+  else
+  {
+    /* Send nop command to display, we only care about the data being sent
+    back from the ezLCD.*/
     button = ezLCD_transfer_data(0);
-    
-    if((button & 0xC0)>>6 == 2) /* If button state is UP */
-    
-    /* This if statement will only be entered AFTER the below "else if" has been
-     * executed since the ezButton does not send any data about buttons which
-     * have never been pressed. */
-    {
-      released = 1;           /*set the released flag to 1 so we may exit loop*/
-      /* Return the button image to its UP position */
-      ezLCD_set_button_state(button & 0x3F, EZLCD_BUTTON_UP);
-    }     
-    else if((button & 0xC0)>>6 == 1) /* Else if button state is DOWN */
+  }
+  
+  if((button & 0xC0)>>6 == 2) /* If button state is UP */
+  {
+    /* Return the button image to its UP position */
+    ezLCD_set_button_state(button & 0x3F, EZLCD_BUTTON_UP);
+    *id = button & 0x3F;
+    ++poll_active;
+    return EZLCD_EVENT_RELEASE;
+  }
+  else if((button & 0xC0)>>6 == 1) /* Else if button state is DOWN */
+  {
+    /* Set the button image to its DOWN position */
+    ezLCD_set_button_state(button & 0x3F, EZLCD_BUTTON_DOWN);
+    *id = button & 0x3F;
+    ++poll_active;
+    return EZLCD_EVENT_PRESS;
+  }
+  
+  ++poll_idle;
+  return EZLCD_EVENT_NONE;
+}
+
+void ezLCD_button_on(ezLCD_button_handlers_t *table,
+                     uint8_t id,
+                     ezLCD_event_t event,
+                     ezLCD_button_handler_t handler)
+{
+  if(id >= EZLCD_BUTTON_HANDLER_IDS ||
+     event < EZLCD_EVENT_PRESS || event > EZLCD_EVENT_LONG_PRESS)
+    return;
+  
+  table->handler[id][event - EZLCD_EVENT_PRESS] = handler;
+}
+
+void ezLCD_button_handlers_use(ezLCD_button_handlers_t *table)
+{
+  handlers = table;
+}
+
+ezLCD_event_t ezLCD_button_dispatch(void)
+{
+  ezLCD_button_handler_t handler;
+  ezLCD_event_t event;
+  uint8_t  id;
+  uint16_t now = ezLCD_event_clock();
+  
+  event = ezLCD_poll_event(&id);
+  if(event == EZLCD_EVENT_PRESS)
+  {
+    if(id == held_id)
+      event = EZLCD_EVENT_NONE;         /* The display repeating a held press */
+    else
     {
-      /* Set the button image to its DOWN position */
-      ezLCD_set_button_state(button & 0x3F, EZLCD_BUTTON_DOWN);
+      held_id    = id;
+      held_since = now;
+      held_long  = 0;
     }
   }
-  return button & 0x3F; /*Return the ID of the pressed button, making sure to
-                         * mask out the now unneeded status bits.
-                         */
+  else if(event == EZLCD_EVENT_RELEASE)
+    held_id = NO_BUTTON;
+  
+  if(event == EZLCD_EVENT_NONE)
+  {
+    if(held_id == NO_BUTTON || held_long ||
+       (uint16_t)(now - held_since) < EZLCD_BUTTON_LONG_TICKS)
+      return EZLCD_EVENT_NONE;
+    
+    held_long = 1;
+    id        = held_id;
+    event     = EZLCD_EVENT_LONG_PRESS;
+  }
+  
+  if(handlers && id < EZLCD_BUTTON_HANDLER_IDS)
+  {
+    handler = handlers->handler[id][event - EZLCD_EVENT_PRESS];
+    if(handler)
+      handler(id, event);
+  }
+  
+  return event;
 }
 /** @} */ /* ezLCD_103_buttons */
 
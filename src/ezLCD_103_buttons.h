@@ -105,6 +105,46 @@ typedef enum { ezButton = 1,
                cuButton = 2,
                calibratedXY = 64} ezLCD_touch_protocol_t;
 
+/** Enumerated types returned by the ezLCD_poll_event() function to indicate
+  * what, if anything, happened since the last poll.
+  */
+typedef enum { EZLCD_EVENT_NONE = 0,
+               EZLCD_EVENT_PRESS,
+               EZLCD_EVENT_RELEASE,
+               EZLCD_EVENT_LONG_PRESS   /**< ezLCD_button_dispatch() only */
+             } ezLCD_event_t;
+
+/** A function called by ezLCD_button_dispatch() with the ID of the button
+  * and what happened to it.
+  */
+typedef void (*ezLCD_button_handler_t)(uint8_t id, ezLCD_event_t event);
+
+/** The handlers of one page for ezLCD_button_dispatch(), one per button ID
+  * below EZLCD_BUTTON_HANDLER_IDS and event, indexed
+  * [id][event - EZLCD_EVENT_PRESS]. Empty entries are 0. It may be filled in
+  * with ezLCD_button_on() or written out as an initialized table.
+  */
+typedef struct
+{
+  ezLCD_button_handler_t handler[EZLCD_BUTTON_HANDLER_IDS][3];
+} ezLCD_button_handlers_t;
+
+/** Describes one button for ezLCD_button_define_batch(). The fields are the
+  * parameters of ezLCD_button_define_long().
+  */
+typedef struct
+{
+  uint8_t              id;              /**< Button ID in the set [0,63] */
+  ezLCD_button_state_t state;           /**< Initial state */
+  uint16_t             index_up;        /**< ROM index of the UP image */
+  uint16_t             index_down;      /**< ROM index of the DOWN image */
+  uint16_t             index_disabled;  /**< ROM index of the DISABLED image */
+  uint16_t             x;               /**< X of the top-left corner */
+  uint16_t             y;               /**< Y of the top-left corner */
+  uint8_t              width;           /**< Touch zone width */
+  uint8_t              height;          /**< Touch zone height */
+} ezLCD_button_t;
+
 /*----------------------------------------------------------------------------*/
 /* FUNCTIONS                                                                  */
 /*----------------------------------------------------------------------------*/
@@ -194,8 +234,58 @@ void ezLCD_button_define_long(uint8_t id,
                               uint8_t width,
                               uint8_t height);
 
+/** Defines several buttons at once. All of the button definitions are sent
+ *  back to back while the display stays selected, so a whole keypad costs one
+ *  chip select transaction and one call instead of one per button. See
+ *  ezLCD_button_define_long() for the meaning of each descriptor field.
+ *  Descriptors whose ID is above 63 are skipped.
+ *
+ *  @par Parameters
+ *      - @a buttons = Array of button descriptors.
+ *      - @a count   = Number of descriptors in @a buttons.
+ *
+ *  @par Assumptions
+ *       - Same as ezLCD_button_define_long().
+ */
+void ezLCD_button_define_batch(const ezLCD_button_t *buttons, uint8_t count);
+
+/** Shows a page of buttons, sending only what differs from the buttons the
+ *  display already holds. The driver remembers the definitions it sent for
+ *  buttons 0 to EZLCD_BUTTON_CACHE_IDS - 1, and for every button of the page:
+ *
+ *  - a button defined the same way is only set to its state with 0xB1, and
+ *    only if that state differs or @a repaint is set,
+ *  - any other button is defined in full with 0xB5.
+ *
+ *  Buttons of the previous page which this page does not list are set to
+ *  EZLCD_BUTTON_INVISIBLE, so they stop responding while their definitions
+ *  stay live for the next page that uses them. Everything is sent under one
+ *  chip select.
+ *
+ *  When the driver knows nothing about the display's buttons, e.g. after
+ *  power up, ezLCD_deactivate_all_buttons() or a display list replay, the
+ *  page starts with deactivating all buttons and defines every button.
+ *
+ *  @par Parameters
+ *      - @a buttons = The buttons of the page, a constant table in flash.
+ *                     Tables in RAM are not supported.
+ *      - @a count   = Number of descriptors in @a buttons.
+ *      - @a repaint = 1 if the page's background has just been drawn over the
+ *                     old buttons, so unchanged buttons must be painted
+ *                     again. 0 if the screen still shows them.
+ *
+ *  @par Assumptions
+ *       - Same as ezLCD_button_define_long().
+ */
+void ezLCD_button_page(const EZLCD_FLASH ezLCD_button_t *buttons,
+                       uint8_t count,
+                       uint8_t repaint);
+
 /** Sets the touch protocol for the entire screen. That is, this setting applies
- *  to all buttons placed on the screen and not just one button.
+ *  to all buttons placed on the screen and not just one button. Selecting
+ *  ezButton or calibratedXY also turns on harvesting of that protocol's
+ *  packets during drawing commands (see ezLCD_event_harvest()); cuButton
+ *  turns it off.
  *
  * @par Parameters 
  *      - @a protocol = An enumerated type indicating the desired touch 
@@ -215,7 +305,12 @@ void ezLCD_button_define_long(uint8_t id,
 void ezLCD_set_touch_protocol(ezLCD_touch_protocol_t protocol);
 
 /** Sets the display state of a button and therefore changes the button's 
- *  image on the screen (if supplied).
+ *  image on the screen (if supplied). The driver remembers the state of each
+ *  button it defined or changed, so nothing is sent when the button already
+ *  has the requested state; see ezLCD_button_suppressed(). The table is
+ *  forgotten along with the rest of the shadow state (see
+ *  ezLCD_state_invalidate()) and by ezLCD_all_buttons_up() and
+ *  ezLCD_deactivate_all_buttons().
  *
  * @par Parameters 
  *      - @a id = The ID of the button whose state is to be changed.
@@ -235,6 +330,19 @@ void ezLCD_set_touch_protocol(ezLCD_touch_protocol_t protocol);
  */
 void ezLCD_set_button_state(uint8_t id, ezLCD_button_state_t state);
 
+/** Reports how many ezLCD_set_button_state() calls were dropped because the
+ *  button already had the requested state, since the last
+ *  ezLCD_button_suppressed_reset(). ezLCD_wait_for_event() and
+ *  ezLCD_poll_event() account for most of them when the display repeats a
+ *  DOWN or UP packet.
+ *
+ *  @returns The number of suppressed 0xB1 commands, 3 bytes each.
+ */
+uint16_t ezLCD_button_suppressed(void);
+
+/** Resets the counter returned by ezLCD_button_suppressed() */
+void ezLCD_button_suppressed_reset(void);
+
 /** This function sends a command to the screen to enter its built in 
  *  calibration routine and then waits until the screen has been successfully
  *  calibrated. 
@@ -296,6 +404,9 @@ void ezLCD_all_buttons_up();
  *  DETECT BUTTON PRESSES SINCE THIS FUNCTION MAY NOT BE SUITABLE FOR ALL
  *  APPLICATIONS</b>. This function only works with the ezButton protocol.
  *
+ *  While the screen is idle the display is polled at a decaying rate instead
+ *  of as fast as possible: see ezLCD_set_poll_policy() and EZLCD_POLL_IDLE().
+ *
  * @par Assumptions 
  *       - The selected touch protocol is ezButton. 
  *       - The buttons being polled are initially in the EZLCD_BUTTON_UP state.
@@ -313,5 +424,118 @@ void ezLCD_all_buttons_up();
  */
 uint8_t ezLCD_wait_for_event();
 
+/** Non-blocking version of ezLCD_wait_for_event(). Each call first takes a
+ *  packet harvested during earlier drawing commands (see ezLCD_event_get()).
+ *  Only when none is waiting does it exchange one no-op byte with the display
+ *  and decode the ezButton packet that comes back. Just like
+ *  ezLCD_wait_for_event(), a pressed button is switched to its
+ *  EZLCD_BUTTON_DOWN image and a released button back to its EZLCD_BUTTON_UP
+ *  image before returning.
+ *
+ *  A call that finds nothing costs one SPI byte time. The worst case is a
+ *  call which polls and finds a button whose image must change: the no-op
+ *  byte plus the 3 byte 0xB1 state command, 4 byte times in 2 transactions.
+ *  With EZLCD_SPI_INTERRUPT it also first waits for commands still queued
+ *  for the SPI interrupt. It may be called from a fixed-rate control loop
+ *  whose period allows for that.
+ *
+ *  @par Parameters
+ *       - @a id = Where the ID of the pressed or released button is stored. It
+ *         is left untouched when no event is returned.
+ *
+ * @par Assumptions 
+ *       - The selected touch protocol is ezButton. 
+ *       - The user has initialized the MCU's SPI interface with the
+ *         EZLCD_INIT_SPI() macro.
+ *       - The user has set the MCU's SPI pins to inputs and outputs 
+ *         appropriately. <BR><BR>
+ *         - SS_BAR = OUTPUT
+ *         - SCK    = OUTPUT
+ *         - MOSI   = OUTPUT
+ *         - MISO   = INPUT
+ * @returns
+ *           -EZLCD_EVENT_PRESS, EZLCD_EVENT_RELEASE or EZLCD_EVENT_NONE
+ *
+ */
+ezLCD_event_t ezLCD_poll_event(uint8_t *id);
+
+/** Sets how often ezLCD_wait_for_event() polls the display. Right after a
+ *  touch it waits @a fast units (see EZLCD_POLL_UNIT_CYCLES) between polls,
+ *  and the wait doubles with every poll that finds nothing until it reaches
+ *  @a slow. The defaults are EZLCD_POLL_FAST and EZLCD_POLL_SLOW.
+ *
+ *  @par Parameters
+ *       - @a fast = Interval in units after activity. 0 is taken as 1, since
+ *                   a zero interval would never grow.
+ *       - @a slow = Longest interval in units when idle. Taken as @a fast if
+ *                   smaller.
+ */
+void ezLCD_set_poll_policy(uint16_t fast, uint16_t slow);
+
+/** Reports how many ezLCD_poll_event() calls, including those made by
+ *  ezLCD_wait_for_event(), found nothing since ezLCD_poll_count_reset().
+ *  Compared with ezLCD_poll_active_count() it shows whether the polling
+ *  policy is too eager.
+ *
+ *  @returns The number of idle polls.
+ */
+uint16_t ezLCD_poll_idle_count(void);
+
+/** Reports how many ezLCD_poll_event() calls returned a press or release
+ *  since ezLCD_poll_count_reset().
+ *
+ *  @returns The number of active polls.
+ */
+uint16_t ezLCD_poll_active_count(void);
+
+/** Resets the counters returned by ezLCD_poll_idle_count() and
+ *  ezLCD_poll_active_count().
+ */
+void ezLCD_poll_count_reset(void);
+
+/** Registers the function ezLCD_button_dispatch() calls when @a event
+ *  happens to button @a id while @a table is in use.
+ *
+ *  @par Parameters
+ *       - @a table   = The page's handler table.
+ *       - @a id      = Button ID below EZLCD_BUTTON_HANDLER_IDS. Others are
+ *                      ignored.
+ *       - @a event   = EZLCD_EVENT_PRESS, EZLCD_EVENT_RELEASE or
+ *                      EZLCD_EVENT_LONG_PRESS. Others are ignored.
+ *       - @a handler = The function, or 0 to remove it.
+ */
+void ezLCD_button_on(ezLCD_button_handlers_t *table,
+                     uint8_t id,
+                     ezLCD_event_t event,
+                     ezLCD_button_handler_t handler);
+
+/** Selects the handler table used by ezLCD_button_dispatch(). Switching pages
+ *  costs this one pointer write, however many handlers the pages have. A
+ *  handler may switch tables; the new one applies from the next event.
+ *
+ *  @par Parameters
+ *       - @a table = The table to use, or 0 to call no handlers.
+ */
+void ezLCD_button_handlers_use(ezLCD_button_handlers_t *table);
+
+/** Polls the display once with ezLCD_poll_event() and calls the handler of
+ *  the table in use for the event found. Looking a handler up is one table
+ *  index whatever the number of buttons, unlike a chain of comparisons on
+ *  the ID returned by ezLCD_wait_for_event(). Events of buttons with an ID
+ *  of EZLCD_BUTTON_HANDLER_IDS or more are returned but call no handler.
+ *
+ *  A press is dispatched once however often the display repeats it while the
+ *  button is held. Once a button has been held for EZLCD_BUTTON_LONG_TICKS
+ *  ticks of ezLCD_event_clock(), EZLCD_EVENT_LONG_PRESS is dispatched, once,
+ *  before its release. Long presses therefore need ezLCD_event_tick() to be
+ *  running, e.g. with EZLCD_TOUCH_TIMER.
+ *
+ * @par Assumptions
+ *       - Same as ezLCD_poll_event().
+ * @returns
+ *           -The event dispatched, or EZLCD_EVENT_NONE.
+ */
+ezLCD_event_t ezLCD_button_dispatch(void);
+
 #endif /* EZLCD_BUTTONS_H */
 /** @} */ /* ezLCD_103_buttons */
\ No newline at end of file
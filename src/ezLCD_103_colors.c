@@ -21,48 +21,85 @@
 
 void ezLCD_set_color_rgb(uint8_t red, uint8_t green, uint8_t blue)
 {
- ezLCD_transfer_data_long(0x31,0);
- ezLCD_transfer_data_long(red,0);
- ezLCD_transfer_data_long(green,0);
- ezLCD_transfer_data_long(blue,1);
+ uint8_t rgb[3];
+ 
+ rgb[0] = red;
+ rgb[1] = green;
+ rgb[2] = blue;
+ if(ezLCD_state_match(EZLCD_STATE_COLOR, ezLCD_state.color, rgb, 3)) return;
+ 
+ ezLCD_cmd_put(0x31);
+ ezLCD_cmd_put(red);
+ ezLCD_cmd_put(green);
+ ezLCD_cmd_put(blue);
+ ezLCD_cmd_flush();
 }
 
 void ezLCD_set_alpha(uint8_t alpha)
 {
- ezLCD_transfer_data_long(0x20,0);
- ezLCD_transfer_data_long(alpha,1);
+ if(ezLCD_state_match(EZLCD_STATE_ALPHA, &ezLCD_state.alpha, &alpha, 1)) return;
+ 
+ ezLCD_cmd_put(0x20);
+ ezLCD_cmd_put(alpha);
+ ezLCD_cmd_flush();
 }
 
 void ezLCD_set__tr_color_rgb(uint8_t red, uint8_t green, uint8_t blue)
 {
- ezLCD_transfer_data_long(0x5A,0);
- ezLCD_transfer_data_long(red,0);
- ezLCD_transfer_data_long(green,0);
- ezLCD_transfer_data_long(blue,1);
+ uint8_t tr[4];
+ 
+ tr[0] = 1;                                   /* Transparency enabled */
+ tr[1] = red;
+ tr[2] = green;
+ tr[3] = blue;
+ if(ezLCD_state_match(EZLCD_STATE_TRANSPARENCY, ezLCD_state.transparency,
+                      tr, 4)) return;
+ 
+ ezLCD_cmd_put(0x5A);
+ ezLCD_cmd_put(red);
+ ezLCD_cmd_put(green);
+ ezLCD_cmd_put(blue);
+ ezLCD_cmd_flush();
 }
 
 void ezLCD_tr_color_none(void)
 {
- ezLCD_transfer_data(0x5B);
+ static const uint8_t tr[4] = { 0, 0, 0, 0 };  /* Transparency disabled */
+ 
+ if(ezLCD_state_match(EZLCD_STATE_TRANSPARENCY, ezLCD_state.transparency,
+                      tr, 4)) return;
+ 
+ ezLCD_cmd_put(0x5B);
+ ezLCD_cmd_flush();
 }
 
 void ezLCD_set_background_color(uint8_t red, uint8_t green, uint8_t blue)
 {
- ezLCD_transfer_data_long(0x32,0);
- ezLCD_transfer_data_long(red,0);
- ezLCD_transfer_data_long(green,0);
- ezLCD_transfer_data_long(blue,1);
+ uint8_t rgb[3];
+ 
+ rgb[0] = red;
+ rgb[1] = green;
+ rgb[2] = blue;
+ if(ezLCD_state_match(EZLCD_STATE_BACKGROUND, ezLCD_state.background,
+                      rgb, 3)) return;
+ 
+ ezLCD_cmd_put(0x32);
+ ezLCD_cmd_put(red);
+ ezLCD_cmd_put(green);
+ ezLCD_cmd_put(blue);
+ ezLCD_cmd_flush();
 }
 
 void ezLCD_replace_color(uint8_t o_red, uint8_t o_green, uint8_t o_blue,
                          uint8_t n_red, uint8_t n_green, uint8_t n_blue)
 {
- ezLCD_transfer_data_long(0x5D,0);
- ezLCD_transfer_data_long(o_red,0);
- ezLCD_transfer_data_long(o_green,0);
- ezLCD_transfer_data_long(o_blue,0);
- ezLCD_transfer_data_long(n_red,0);
- ezLCD_transfer_data_long(n_green,0);
- ezLCD_transfer_data_long(n_blue,1);
+ ezLCD_cmd_put(0x5D);
+ ezLCD_cmd_put(o_red);
+ ezLCD_cmd_put(o_green);
+ ezLCD_cmd_put(o_blue);
+ ezLCD_cmd_put(n_red);
+ ezLCD_cmd_put(n_green);
+ ezLCD_cmd_put(n_blue);
+ ezLCD_cmd_flush();
 }
 /** @} */ /* ezLCD_103_colors */
\ No newline at end of file
@@ -16,31 +16,525 @@
 /*----------------------------------------------------------------------------*/
 #include "ezLCD_103_common.h"
 
+/*----------------------------------------------------------------------------*/
+/* VARIABLES                                                                  */
+/*----------------------------------------------------------------------------*/
+ezLCD_state_t ezLCD_state;                        /* Nothing is valid yet */
+
+static uint8_t cmd_buffer[EZLCD_CMD_BUFFER_SIZE]; /* Command staging buffer */
+static uint8_t cmd_length;                        /* Bytes currently staged */
+static ezLCD_cmd_sink_t cmd_sink;                 /* Set while recording */
+
+static ezLCD_touch_event_t event_ring[EZLCD_EVENT_QUEUE_SIZE]; /* Packets */
+static volatile uint8_t  event_head;         /* Written only by the producer */
+static volatile uint8_t  event_tail;         /* Written only by the consumer */
+static volatile uint8_t  event_mode;         /* EZLCD_HARVEST_* */
+static volatile uint16_t event_clock;        /* Ticks of ezLCD_event_tick() */
+
+static uint8_t touch_ring[EZLCD_TOUCH_QUEUE_SIZE]; /* calibratedXY bytes */
+static volatile uint8_t  touch_head;         /* Written only by the producer */
+static volatile uint8_t  touch_tail;         /* Written only by the consumer */
+static uint8_t touch_left;                   /* Data bytes of the packet being
+                                                harvested still to come */
+
+static volatile uint8_t bus_busy;            /* Slave selected by main code */
+static volatile uint8_t bus_claimed;         /* See ezLCD_bus_claim() */
+
+/* Used by main (non-interrupt) code so ezLCD_event_tick() keeps off the bus */
+#define EZLCD_BUS_SELECT()    { bus_busy = 1;                                 \
+                                EZLCD_SLAVE_SELECT(); }
+#define EZLCD_BUS_DESELECT()  { EZLCD_SLAVE_DESELECT();                       \
+                                bus_busy = 0; }
+
+#ifdef EZLCD_SPI_INTERRUPT
+static uint8_t tx_ring[EZLCD_TX_RING_SIZE];  /* Bytes waiting for the ISR */
+static volatile uint8_t tx_head;             /* Written only by the producer */
+static volatile uint8_t tx_tail;             /* Written only by the ISR */
+static volatile uint8_t tx_busy;             /* A byte is being clocked out */
+static volatile uint8_t tx_open;             /* Slave selected by the ring */
+static uint8_t tx_end[(EZLCD_TX_RING_SIZE + 7) / 8]; /* Last byte of command */
+static uint8_t tx_high_water;                /* Deepest the ring has been */
+
+/* Used to bracket polled transfers so the ISR does not consume their SPIF.
+ * SPIE is restored rather than set: ezLCD_event_tick() may run between the
+ * main code clearing it and selecting the slave, and must not turn it back
+ * on under the main code's transfer. */
+#define EZLCD_POLLED_BEGIN()  ezLCD_spi_wait();                               \
+                              { uint8_t ezlcd_spie = EZLCD_SPCR &             \
+                                                     (1 << EZLCD_SPIE);       \
+                                CLEARBIT(EZLCD_SPCR, EZLCD_SPIE);
+#define EZLCD_POLLED_END()      EZLCD_SPCR |= ezlcd_spie; }
+
+/* Access to the end of command marks of the transmit ring slots */
+#define TX_END_SET(slot)      tx_end[(slot) >> 3] |=  (1 << ((slot) & 7));
+#define TX_END_CLEAR(slot)    tx_end[(slot) >> 3] &= ~(1 << ((slot) & 7));
+#define TX_END_MARKED(slot)   (tx_end[(slot) >> 3] & (1 << ((slot) & 7)))
+
+/* Ends the command being sent: the ISR deselects the slave after its last
+ * byte, as the polled code below does */
+#define EZLCD_CMD_END(end)    ezLCD_tx_end(end);
+#else
+#define EZLCD_POLLED_BEGIN()
+#define EZLCD_POLLED_END()
+#define EZLCD_CMD_END(end)    if(end)                                         \
+                                EZLCD_BUS_DESELECT();
+#endif /* EZLCD_SPI_INTERRUPT */
+
 /*----------------------------------------------------------------------------*/
 /* FUNCTIONS                                                                  */
 /*----------------------------------------------------------------------------*/
+
+/* Queues a calibratedXY byte clocked in on MISO if it belongs to a packet:
+ * an X (0x81) or Y (0x82) header and its two data bytes, or a PEN_UP (0x83).
+ * Idle bytes are ignored, and so is a byte that finds the ring full. */
+static void ezLCD_touch_put(uint8_t data)
+{
+     uint8_t head;
+     uint8_t next;
+
+     if(data & 0x80)
+     {
+       touch_left = (data == 0x81 || data == 0x82) ? 2 : 0;
+       if(data < 0x81 || data > 0x83)
+         return;
+     }
+     else if(touch_left)
+       --touch_left;
+     else
+       return;
+
+     head = touch_head;
+     next = (head + 1) & (EZLCD_TOUCH_QUEUE_SIZE - 1);
+     if(next != touch_tail)
+     {
+       touch_ring[head] = data;
+       touch_head = next;
+     }
+}
+
+/* Queues a byte clocked in on MISO, with the time it arrived, if it is an
+ * ezButton DOWN or UP packet. Idle bytes (status 00 or 11) are ignored, and
+ * so is a packet that finds the ring full. In calibratedXY mode the byte goes
+ * to ezLCD_touch_put() instead. Only one producer runs at a time: main code
+ * while it holds the bus, the SPI ISR while the transmit ring drains, and
+ * ezLCD_event_tick() only when neither does. */
+static void ezLCD_event_put(uint8_t packet)
+{
+     uint8_t head;
+     uint8_t next;
+
+     if(event_mode == EZLCD_HARVEST_TOUCH)
+     {
+       ezLCD_touch_put(packet);
+       return;
+     }
+     if(event_mode != EZLCD_HARVEST_BUTTONS)
+       return;
+
+     if((packet & 0xC0) != 0x40 && (packet & 0xC0) != 0x80)
+       return;
+
+     head = event_head;
+     next = (head + 1) & (EZLCD_EVENT_QUEUE_SIZE - 1);
+     if(next != event_tail)
+     {
+       event_ring[head].packet = packet;
+       event_ring[head].stamp  = ezLCD_event_clock();
+       event_head = next;
+     }
+}
+
+#ifdef EZLCD_SPI_INTERRUPT
+/* Starts the ISR chain if it is idle and there is something to send */
+static void ezLCD_tx_start(void)
+{
+     EZLCD_CRITICAL_ENTER()
+     if(!tx_busy && tx_tail != tx_head)
+     {
+       tx_busy = 1;
+       if(!tx_open)
+       {
+         EZLCD_SLAVE_SELECT();                     /* Select the slave */
+         tx_open = 1;
+       }
+       EZLCD_SPDR = tx_ring[tx_tail];              /* send first byte */
+       tx_tail = (tx_tail + 1) & (EZLCD_TX_RING_SIZE - 1);
+     }
+     EZLCD_CRITICAL_EXIT()
+}
+
+/* The slave is deselected after the last byte of each command. If the ring
+ * runs dry in the middle of a command it stays selected until the rest of
+ * the command is queued. */
+EZLCD_SPI_ISR()
+{
+     uint8_t tail = tx_tail;
+     uint8_t sent = (tail - 1) & (EZLCD_TX_RING_SIZE - 1);
+
+     ezLCD_event_put(EZLCD_SPDR);                  /* Byte just clocked in */
+
+     if(TX_END_MARKED(sent))
+     {
+       EZLCD_SLAVE_DESELECT();                     /* Deslelect the slave */
+       tx_open = 0;
+     }
+
+     if(tail != tx_head)
+     {
+       if(!tx_open)
+       {
+         EZLCD_SLAVE_SELECT();                     /* Select the slave */
+         tx_open = 1;
+       }
+       EZLCD_SPDR = tx_ring[tail];                 /* send next byte */
+       tx_tail = (tail + 1) & (EZLCD_TX_RING_SIZE - 1);
+     }
+     else
+       tx_busy = 0;
+}
+
+/* Appends one byte to the transmit ring */
+static void ezLCD_tx_put(uint8_t data)
+{
+     uint8_t next = (tx_head + 1) & (EZLCD_TX_RING_SIZE - 1);
+
+     while(next == tx_tail)           /* Ring is full, wait for the ISR */
+       ezLCD_tx_start();
+
+     TX_END_CLEAR(tx_head)
+     tx_ring[tx_head] = data;
+     tx_head = next;
+}
+
+/* Notes how deep the ring got and lets the ISR send its contents */
+static void ezLCD_tx_kick(void)
+{
+     uint8_t level = (tx_head - tx_tail) & (EZLCD_TX_RING_SIZE - 1);
+
+     if(level > tx_high_water)
+       tx_high_water = level;
+
+     ezLCD_tx_start();
+}
+
+/* Marks the last byte queued as the end of its command, if @a end is set,
+ * and lets the ISR send the ring. A command whose bytes have all gone out
+ * already is ended here instead. */
+static void ezLCD_tx_end(uint8_t end)
+{
+     uint8_t last = (tx_head - 1) & (EZLCD_TX_RING_SIZE - 1);
+
+     if(end)
+     {
+       EZLCD_CRITICAL_ENTER()
+       if(tx_busy || tx_tail != tx_head)
+         TX_END_SET(last)
+       else if(tx_open)
+       {
+         EZLCD_SLAVE_DESELECT();                   /* Deslelect the slave */
+         tx_open = 0;
+       }
+       EZLCD_CRITICAL_EXIT()
+     }
+
+     ezLCD_tx_kick();
+}
+
+/* Moves bytes into the transmit ring, see ezLCD_tx_end() */
+static uint8_t ezLCD_cmd_send(const uint8_t *p, uint8_t length)
+{
+     for(; length != 0; --length)
+       ezLCD_tx_put(*p++);
+
+     return 0;
+}
+
+static void ezLCD_cmd_send_flash(const EZLCD_FLASH uint8_t *p, uint8_t length)
+{
+     for(; length != 0; --length)
+       ezLCD_tx_put(*p++);
+}
+
+void ezLCD_spi_wait(void)
+{
+     while(tx_busy);
+}
+
+uint8_t ezLCD_spi_busy(void)
+{
+     return tx_busy;
+}
+
+uint8_t ezLCD_spi_high_water(void)
+{
+     return tx_high_water;
+}
+
+void ezLCD_spi_high_water_reset(void)
+{
+     tx_high_water = 0;
+}
+#else
+/* Sends bytes with the slave selected, but leaves it selected so the caller
+ * decides whether the command is finished.
+ */
+static uint8_t ezLCD_cmd_send(const uint8_t *p, uint8_t length)
+{
+     EZLCD_BUS_SELECT();                           /* Select the slave */
+
+     for(; length != 0; --length)
+     {
+       EZLCD_SPDR = *p++;                            /* send data */
+       while (!(EZLCD_SPSR & (1<<EZLCD_SPIF_BIT)));  /* wait for transmission */
+       ezLCD_event_put(EZLCD_SPDR);                  /* keep touch events */
+     }
+
+     return EZLCD_SPDR;                            /* return data */
+}
+
+static void ezLCD_cmd_send_flash(const EZLCD_FLASH uint8_t *p, uint8_t length)
+{
+     EZLCD_BUS_SELECT();                           /* Select the slave */
+
+     for(; length != 0; --length)
+     {
+       EZLCD_SPDR = *p++;                            /* send data */
+       while (!(EZLCD_SPSR & (1<<EZLCD_SPIF_BIT)));  /* wait for transmission */
+       ezLCD_event_put(EZLCD_SPDR);                  /* keep touch events */
+     }
+}
+
+void ezLCD_spi_wait(void)
+{
+}
+
+uint8_t ezLCD_spi_busy(void)
+{
+     return 0;
+}
+
+uint8_t ezLCD_spi_high_water(void)
+{
+     return 0;
+}
+
+void ezLCD_spi_high_water_reset(void)
+{
+}
+#endif /* EZLCD_SPI_INTERRUPT */
+
+/* Hands the staged bytes to the sink if one is installed, otherwise sends
+ * them and deselects the slave at the end of the command.
+ */
+static uint8_t ezLCD_cmd_drain(uint8_t end)
+{
+     uint8_t data = 0;
+
+     if(cmd_sink)
+       cmd_sink(cmd_buffer, cmd_length, end);
+     else
+     {
+       data = ezLCD_cmd_send(cmd_buffer, cmd_length);
+       EZLCD_CMD_END(end)                          /* Deslelect the slave */
+     }
+
+     cmd_length = 0;
+     return data;
+}
+
+void ezLCD_cmd_put(uint8_t data)
+{
+     if(cmd_length == EZLCD_CMD_BUFFER_SIZE)
+       ezLCD_cmd_drain(0);            /* Drain, the slave stays selected */
+
+     cmd_buffer[cmd_length++] = data;
+}
+
+void ezLCD_cmd_put16(uint16_t data)
+{
+     ezLCD_cmd_put(data >> 8);
+     ezLCD_cmd_put(data & 0xFF);
+}
+
+uint8_t ezLCD_cmd_flush(void)
+{
+     return ezLCD_cmd_drain(1);
+}
+
+void ezLCD_cmd_redirect(ezLCD_cmd_sink_t sink)
+{
+     cmd_sink = sink;
+}
+
+void ezLCD_cmd_write(const uint8_t *data, uint8_t length, uint8_t end)
+{
+     ezLCD_cmd_send(data, length);
+     EZLCD_CMD_END(end)                            /* Deslelect the slave */
+}
+
+void ezLCD_cmd_write_flash(const EZLCD_FLASH uint8_t *data,
+                           uint8_t length,
+                           uint8_t end)
+{
+     ezLCD_cmd_send_flash(data, length);
+     EZLCD_CMD_END(end)                            /* Deslelect the slave */
+}
+
 uint8_t ezLCD_transfer_data(uint8_t data)
 {
-     EZLCD_SLAVE_SELECT();                         /* Select the slave */
+     EZLCD_POLLED_BEGIN()
+     EZLCD_BUS_SELECT();                           /* Select the slave */
      EZLCD_SPDR = data;                            /* send data */
      while (!(EZLCD_SPSR & (1<<EZLCD_SPIF_BIT)));  /* wait for transmission to complete */
-     EZLCD_SLAVE_DESELECT();                       /* Deslelect the slave */
-     return EZLCD_SPDR;                            /* return data */
+     data = EZLCD_SPDR;                            /* read data */
+     EZLCD_BUS_DESELECT();                         /* Deslelect the slave */
+     EZLCD_POLLED_END()
+     return data;                                  /* return data */
 }
 
 
 /* assumes user hasn't deselected the pin mid-transfer */
 uint8_t ezLCD_transfer_data_long(uint8_t data, uint8_t end_transfer)
 {
-     EZLCD_SLAVE_SELECT();                         /* Select the slave */
+     EZLCD_POLLED_BEGIN()
+     EZLCD_BUS_SELECT();                           /* Select the slave */
      EZLCD_SPDR = data;                            /* send data */
      while (!(EZLCD_SPSR & (1<<EZLCD_SPIF_BIT)));  /* wait for transmission to complete */
+     data = EZLCD_SPDR;           /* Read data before the bus can be reused */
 
      if(end_transfer == 1)
-       EZLCD_SLAVE_DESELECT();     /* Deslelect the slave if transfer
+       EZLCD_BUS_DESELECT();       /* Deslelect the slave if transfer
                                     * is complete
                                     */
 
-     return EZLCD_SPDR;           /* Return data */
+     EZLCD_POLLED_END()
+     return data;                 /* Return data */
+}
+
+uint8_t ezLCD_state_match(uint16_t field,
+                          uint8_t *shadow,
+                          const uint8_t *value,
+                          uint8_t length)
+{
+     uint8_t i;
+     uint8_t same = (ezLCD_state.valid & field) != 0;
+
+     for(i = 0; i < length; ++i)
+     {
+       if(shadow[i] != value[i])
+       {
+         shadow[i] = value[i];
+         same = 0;
+       }
+     }
+
+     ezLCD_state.valid |= field;
+     return same;
+}
+
+void ezLCD_state_invalidate(void)
+{
+     ezLCD_state.valid = 0;
+}
+
+void ezLCD_event_harvest(uint8_t mode)
+{
+     event_mode = mode;
+     if(mode != EZLCD_HARVEST_BUTTONS)
+       event_tail = event_head;                    /* Drop stale packets */
+     if(mode != EZLCD_HARVEST_TOUCH)
+     {
+       touch_tail = touch_head;
+       touch_left = 0;
+     }
+}
+
+uint8_t ezLCD_event_get(ezLCD_touch_event_t *event)
+{
+     uint8_t tail = event_tail;
+
+     if(tail == event_head)
+       return 0;
+
+     *event = event_ring[tail];
+     event_tail = (tail + 1) & (EZLCD_EVENT_QUEUE_SIZE - 1);
+
+     event->latency = ezLCD_event_clock() - event->stamp;
+     return 1;
+}
+
+uint8_t ezLCD_event_touch_get(uint8_t *data)
+{
+     uint8_t tail = touch_tail;
+
+     if(tail == touch_head)
+       return 0;
+
+     *data = touch_ring[tail];
+     touch_tail = (tail + 1) & (EZLCD_TOUCH_QUEUE_SIZE - 1);
+     return 1;
+}
+
+uint16_t ezLCD_event_clock(void)
+{
+     uint16_t now;
+
+     EZLCD_CRITICAL_ENTER()
+     now = event_clock;
+     EZLCD_CRITICAL_EXIT()
+     return now;
+}
+
+uint8_t ezLCD_event_poll(void)
+{
+     uint8_t data;
+
+     EZLCD_POLLED_BEGIN()
+     EZLCD_BUS_SELECT();                           /* Select the slave */
+     EZLCD_SPDR = 0;                               /* send no-op */
+     while (!(EZLCD_SPSR & (1<<EZLCD_SPIF_BIT)));  /* wait for transmission */
+     data = EZLCD_SPDR;
+     ezLCD_event_put(data);                        /* keep touch events */
+     EZLCD_BUS_DESELECT();                         /* Deslelect the slave */
+     EZLCD_POLLED_END()
+     return data;
+}
+
+void ezLCD_event_tick(void)
+{
+     ++event_clock;
+
+     /* Poll only while nothing else is using the bus */
+#ifdef EZLCD_SPI_INTERRUPT
+     if(tx_busy || tx_open)
+       return;
+#endif
+     if(!event_mode || bus_busy || bus_claimed)
+       return;
+
+     EZLCD_POLLED_BEGIN()
+     EZLCD_SLAVE_SELECT();                         /* Select the slave */
+     EZLCD_SPDR = 0;                               /* send no-op */
+     while (!(EZLCD_SPSR & (1<<EZLCD_SPIF_BIT)));  /* wait for transmission */
+     EZLCD_SLAVE_DESELECT();                       /* Deslelect the slave */
+     ezLCD_event_put(EZLCD_SPDR);
+     EZLCD_POLLED_END()
+}
+
+#ifdef EZLCD_TOUCH_TIMER
+EZLCD_TOUCH_TIMER_ISR()
+{
+     ezLCD_event_tick();
+}
+#endif /* EZLCD_TOUCH_TIMER */
+
+void ezLCD_bus_claim(void)
+{
+     bus_claimed = 1;
+}
+
+void ezLCD_bus_release(void)
+{
+     bus_claimed = 0;
 }
 /** @} */ /* ezLCD_103_common */
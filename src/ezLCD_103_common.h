@@ -43,8 +43,16 @@
 #define CLEARBIT(port,bit) ((port) &= ~(1 << (bit)))
 #endif /* CLEARBIT */
 
+/** SPI interrupt enable state, set only when EZLCD_SPI_INTERRUPT is defined */
+#ifdef EZLCD_SPI_INTERRUPT
+#define EZLCD_SPIE_STATE 1
+#else
+#define EZLCD_SPIE_STATE 0
+#endif /* EZLCD_SPI_INTERRUPT */
+
 /**Initialize SPI communication:                                           <BR>
- * SPIE - SPI Interrupt DISABLED (we will poll instead)                    <BR>
+ * SPIE - SPI Interrupt DISABLED (we will poll instead) unless             <BR>
+ *        EZLCD_SPI_INTERRUPT is defined                                   <BR>
  * SPE  - SPI ENABLED                                                      <BR>
  * DORD - MSB First                                                        <BR>
  * MSTR - Configured as a MASTER                                           <BR>
@@ -56,7 +64,7 @@
  * SPR2X - CLEARED                                                         <BR>
  */
 #ifdef EZLCD_SPR2X
-#define EZLCD_INIT_SPI() EZLCD_SPCR = ((0 << EZLCD_SPIE) |                    \
+#define EZLCD_INIT_SPI() EZLCD_SPCR = ((EZLCD_SPIE_STATE << EZLCD_SPIE) |     \
                                       (1 <<  EZLCD_SPE)  |                    \
                                       (0 <<  EZLCD_DORD) |                    \
                                       (1 <<  EZLCD_MSTR) |                    \
@@ -66,7 +74,7 @@
                                       (0 <<  EZLCD_SPR0));                    \
                         CLEARBIT(EZLCD_SPSR, EZLCD_SPR2X);
 #else
-#define EZLCD_INIT_SPI() EZLCD_SPCR = ((0 << EZLCD_SPIE) |                    \
+#define EZLCD_INIT_SPI() EZLCD_SPCR = ((EZLCD_SPIE_STATE << EZLCD_SPIE) |     \
                                       (1 <<  EZLCD_SPE)  |                    \
                                       (0 <<  EZLCD_DORD) |                    \
                                       (1 <<  EZLCD_MSTR) |                    \
@@ -87,12 +95,73 @@
 /* TYPEDEFS                                                                   */
 /*----------------------------------------------------------------------------*/
 
+#ifndef EZLCD_HAVE_STDINT
 typedef unsigned char  uint8_t    /** portable 8-bit unsigned integer */  ;
 typedef signed char     int8_t    /** portable 8-bit signed integer */    ;
 typedef unsigned int  uint16_t    /** portable 16-bit unsigned integer */ ;
 typedef signed int     int16_t    /** portable 16-bit signed integer */   ;
 typedef unsigned long uint32_t    /** portable 32-bit unsigned number */  ;
-typedef unsigned long  int32_t    /** portable 32-bit signed number */    ;
+typedef signed long    int32_t    /** portable 32-bit signed number */    ;
+#endif /* EZLCD_HAVE_STDINT */
+
+/** Modes of ezLCD_event_harvest() */
+#define EZLCD_HARVEST_OFF         0       /**< Returned bytes are dropped */
+#define EZLCD_HARVEST_BUTTONS     1       /**< ezButton packets */
+#define EZLCD_HARVEST_TOUCH       2       /**< calibratedXY packet bytes */
+
+/** Bits of ezLCD_state_t::valid, one per shadowed setting */
+#define EZLCD_STATE_COLOR         0x0001  /**< ezLCD_set_color_rgb() */
+#define EZLCD_STATE_BACKGROUND    0x0002  /**< ezLCD_set_background_color() */
+#define EZLCD_STATE_ALPHA         0x0004  /**< ezLCD_set_alpha() */
+#define EZLCD_STATE_PEN           0x0008  /**< ezLCD_set_pen_size() */
+#define EZLCD_STATE_FONT          0x0010  /**< Either font setter */
+#define EZLCD_STATE_UNICODE_BASE  0x0020  /**< ezLCD_set_ttf_unicode_base() */
+#define EZLCD_STATE_DRAW_FRAME    0x0040  /**< ezLCD_set_draw_frame() */
+#define EZLCD_STATE_DISPLAY_FRAME 0x0080  /**< ezLCD_set_display_frame() */
+#define EZLCD_STATE_TRANSPARENCY  0x0100  /**< Transparent color setters */
+#define EZLCD_STATE_BUTTONS       0x0200  /**< Button states, see buttons */
+
+/** Shadow of the display's drawing state. A setting is only trusted when its
+ *  bit is set in @a valid; the setters use it to drop commands that would not
+ *  change anything.
+ */
+typedef struct
+{
+  uint16_t valid;            /**< EZLCD_STATE_* bits of the trusted fields */
+  uint8_t  color[3];         /**< Current color, RGB */
+  uint8_t  background[3];    /**< Background color, RGB */
+  uint8_t  alpha;            /**< Transparency alpha */
+  uint8_t  pen;              /**< Pen size */
+  uint8_t  font[4];          /**< Font opcode, number, height and width */
+  uint8_t  unicode_base[2];  /**< TTF Unicode base, MSB first */
+  uint8_t  draw_frame;       /**< Drawing frame */
+  uint8_t  display_frame;    /**< Display frame */
+  uint8_t  transparency[4];  /**< Enabled flag and transparent color, RGB */
+  uint8_t  buttons[32];      /**< State of buttons 0-63, one nibble each,
+                                  0 when unknown */
+} ezLCD_state_t;
+
+/** Receives staged command bytes in place of the SPI bus, see
+ *  ezLCD_cmd_redirect(). @a end is 1 when the bytes finish the command and 0
+ *  when the staging buffer was merely full.
+ */
+typedef void (*ezLCD_cmd_sink_t)(const uint8_t *data,
+                                 uint8_t length,
+                                 uint8_t end);
+
+/** A harvested ezButton packet, see ezLCD_event_get() */
+typedef struct
+{
+  uint8_t  packet;           /**< Raw packet: ID in bits 0-5, state in 6-7 */
+  uint16_t stamp;            /**< ezLCD_event_clock() when it arrived */
+  uint16_t latency;          /**< Ticks between arrival and ezLCD_event_get() */
+} ezLCD_touch_event_t;
+
+/*----------------------------------------------------------------------------*/
+/* VARIABLES                                                                  */
+/*----------------------------------------------------------------------------*/
+/** The driver's shadow of the display's drawing state */
+extern ezLCD_state_t ezLCD_state;
 
 /*----------------------------------------------------------------------------*/
 /* FUNCTIONS                                                                  */
@@ -146,5 +215,226 @@ uint8_t ezLCD_transfer_data(uint8_t data);
  */
 uint8_t ezLCD_transfer_data_long(uint8_t data, uint8_t end_transfer);
 
+/** Appends one byte to the command staging buffer. Nothing is sent until
+ *  ezLCD_cmd_flush() is called, except when the buffer (of size
+ *  EZLCD_CMD_BUFFER_SIZE) is full, in which case its contents are sent 
+ *  immediately while the display stays selected. This lets an entire command
+ *  of any length go out under one chip select assertion.
+ *
+ *  @par Parameters
+ *        - @a data = the byte that is to be queued for the SPI slave.
+ *
+ *  @par Assumptions
+ *       - The user has initialized the MCU's SPI interface with the
+ *         EZLCD_INIT_SPI() macro.
+ *       - Every command started with this function is finished with 
+ *         ezLCD_cmd_flush().
+ */
+void ezLCD_cmd_put(uint8_t data);
+
+/** Appends a 16-bit value to the command staging buffer, most significant
+ *  byte first, as expected by all of the ezLCD's 16-bit parameters.
+ *
+ *  @par Parameters
+ *        - @a data = the word that is to be queued for the SPI slave.
+ *
+ *  @par Assumptions
+ *       - Same as ezLCD_cmd_put().
+ */
+void ezLCD_cmd_put16(uint16_t data);
+
+/** Sends everything in the command staging buffer to the display under a
+ *  single chip select assertion and then deselects the display.
+ *
+ *  @par Assumptions
+ *       - The user has initialized the MCU's SPI interface with the
+ *         EZLCD_INIT_SPI() macro.
+ *       - The user has set the MCU's SPI pins to inputs and outputs 
+ *         appropriately. <BR><BR>
+ *         - SS_BAR = OUTPUT
+ *         - SCK    = OUTPUT
+ *         - MOSI   = OUTPUT
+ *         - MISO   = INPUT
+ *
+ *  @returns The contents of the SPI data register (EZLCD_SPDR) after the
+ *           last byte has been sent. When EZLCD_SPI_INTERRUPT is defined the
+ *           bytes are only queued and 0 is returned.
+ */
+uint8_t ezLCD_cmd_flush(void);
+
+/** Sends everything staged with ezLCD_cmd_put() to @a sink instead of the
+ *  display, until called again with 0. Used by the display list recorder.
+ *  Bytes sent with ezLCD_transfer_data(), ezLCD_transfer_data_long() and
+ *  ezLCD_cmd_write() always go to the display.
+ *
+ *  @par Parameters
+ *        - @a sink = Function receiving the bytes, or 0 to send them again.
+ */
+void ezLCD_cmd_redirect(ezLCD_cmd_sink_t sink);
+
+/** Sends bytes that were encoded beforehand straight to the display, with
+ *  none of the staging done by ezLCD_cmd_put(). This is the fastest way to
+ *  get a prepared command sequence onto the bus.
+ *
+ *  @par Parameters
+ *        - @a data   = The bytes to send.
+ *        - @a length = Number of bytes.
+ *        - @a end    = 1 if the bytes finish a command so the display is
+ *                      deselected afterwards, 0 if more bytes of the same 
+ *                      command follow.
+ *
+ *  @par Assumptions
+ *       - No command is half staged with ezLCD_cmd_put().
+ *       - The user has initialized the MCU's SPI interface with the
+ *         EZLCD_INIT_SPI() macro.
+ */
+void ezLCD_cmd_write(const uint8_t *data, uint8_t length, uint8_t end);
+
+/** Same as ezLCD_cmd_write() for bytes stored in flash. */
+void ezLCD_cmd_write_flash(const EZLCD_FLASH uint8_t *data,
+                           uint8_t length,
+                           uint8_t end);
+
+/** Blocks until every byte handed to ezLCD_cmd_flush() has been clocked out
+ *  and the display has been deselected. When EZLCD_SPI_INTERRUPT is defined,
+ *  commands are drained by the SPI interrupt in the background; this is the
+ *  function to call before anything that depends on the display having 
+ *  received them. In polled mode it returns immediately.
+ *
+ *  @par Assumptions
+ *       - Global interrupts are enabled (interrupt mode only).
+ */
+void ezLCD_spi_wait(void);
+
+/** Tells whether the SPI interrupt is still draining the transmit ring.
+ *
+ *  @returns 1 if a transfer is in progress, 0 otherwise. Always 0 in polled
+ *           mode.
+ */
+uint8_t ezLCD_spi_busy(void);
+
+/** Reports the largest number of bytes that have been waiting in the
+ *  transmit ring at once since the last ezLCD_spi_high_water_reset(). A value
+ *  that reaches EZLCD_TX_RING_SIZE - 1 means the ring was full and the caller
+ *  had to wait for it, so EZLCD_TX_RING_SIZE should be increased.
+ *
+ *  @returns The high-water mark in bytes. Always 0 in polled mode.
+ */
+uint8_t ezLCD_spi_high_water(void);
+
+/** Resets the counter returned by ezLCD_spi_high_water() */
+void ezLCD_spi_high_water_reset(void);
+
+/** Compares a setting against the shadow kept in ezLCD_state and records the
+ *  new value. Setters call this first and skip sending their command when it
+ *  returns 1. This is how the driver avoids, for instance, re-sending the
+ *  text color before every character printed by putchar().
+ *
+ *  @par Parameters
+ *       - @a field  = The EZLCD_STATE_* bit of the setting.
+ *       - @a shadow = The setting's field in ezLCD_state.
+ *       - @a value  = The value about to be sent.
+ *       - @a length = Size of the setting in bytes.
+ *
+ *  @returns 1 if the display already holds @a value, 0 if it must be sent.
+ */
+uint8_t ezLCD_state_match(uint16_t field,
+                          uint8_t *shadow,
+                          const uint8_t *value,
+                          uint8_t length);
+
+/** Forgets the whole shadow state so the next call to every setter is sent
+ *  to the display. The driver does this itself at power-up 
+ *  (EZLCD_POWER_ON()) and after ezLCD_calibrate_screen(). The user must call
+ *  it after anything else that changes the display's state behind the 
+ *  driver's back, such as resetting the display.
+ */
+void ezLCD_state_invalidate(void);
+
+/** Selects what is harvested from the bytes the display returns during
+ *  commands sent with ezLCD_cmd_flush(). With EZLCD_HARVEST_BUTTONS, DOWN and
+ *  UP packets (ID in bits 0-5, state in bits 6-7) are queued for
+ *  ezLCD_event_get(). With EZLCD_HARVEST_TOUCH, the bytes of calibratedXY
+ *  packets are queued for ezLCD_event_touch_get(), which
+ *  ezLCD_touch_poll() reads before polling. This way a touch, or the pen
+ *  going up, during a long redraw is not lost and no no-op bytes are needed
+ *  to see it. Leaving a mode empties its queue. ezLCD_set_touch_protocol()
+ *  calls this, so the user rarely needs to.
+ *
+ *  The bytes returned by ezLCD_transfer_data() and
+ *  ezLCD_transfer_data_long() belong to their caller and are never queued.
+ *
+ *  @par Parameters
+ *       - @a mode = EZLCD_HARVEST_BUTTONS for the ezButton protocol,
+ *                   EZLCD_HARVEST_TOUCH for calibratedXY, or
+ *                   EZLCD_HARVEST_OFF.
+ */
+void ezLCD_event_harvest(uint8_t mode);
+
+/** Takes the oldest harvested ezButton packet from the queue. Packets arriving
+ *  while the queue holds EZLCD_EVENT_QUEUE_SIZE - 1 of them are dropped.
+ *  Along with the packet comes the tick it arrived on and the number of ticks
+ *  it waited in the queue, i.e. the press-to-handle latency.
+ *
+ *  The queue is lock-free: packets are added by whichever of the main code,
+ *  the SPI interrupt or ezLCD_event_tick() holds the bus, and taken by the
+ *  main code only.
+ *
+ *  @par Parameters
+ *       - @a event = Where the packet, its time stamp and latency are stored.
+ *
+ *  @returns 1 if a packet was taken, 0 if the queue is empty.
+ */
+uint8_t ezLCD_event_get(ezLCD_touch_event_t *event);
+
+/** Takes the oldest byte of a harvested calibratedXY packet. Bytes arriving
+ *  while the queue holds EZLCD_TOUCH_QUEUE_SIZE - 1 of them are dropped. Like
+ *  ezLCD_event_get(), it must only be called by the main code.
+ *
+ *  @par Parameters
+ *       - @a data = Where the byte is stored.
+ *
+ *  @returns 1 if a byte was taken, 0 if the queue is empty.
+ */
+uint8_t ezLCD_event_touch_get(uint8_t *data);
+
+/** Polls the display with one no-op byte from the main code and harvests the
+ *  reply the way the replies to commands are, so it joins the queue behind
+ *  anything harvested before it.
+ *
+ *  @returns The byte the display returned.
+ */
+uint8_t ezLCD_event_poll(void);
+
+/** Reads the tick counter advanced by ezLCD_event_tick(). It stays at 0 when
+ *  ezLCD_event_tick() is never called.
+ *
+ *  @returns The number of ticks so far, wrapping at 65536.
+ */
+uint16_t ezLCD_event_clock(void);
+
+/** Advances the event clock by one tick and, if the bus is free, polls the
+ *  display with one no-op byte so that packets are queued even while the main
+ *  code is busy elsewhere. It is meant to be called from a periodic timer
+ *  interrupt: defining EZLCD_TOUCH_TIMER in the user configuration installs
+ *  such a handler on Timer0, started with EZLCD_INIT_TOUCH_TIMER(). Users who
+ *  already own a periodic interrupt may call this from it instead.
+ *
+ *  The display is only polled while harvesting is on (see
+ *  ezLCD_event_harvest()), the main code is not in the middle of a transfer,
+ *  the SPI interrupt is not draining commands and the bus is not claimed
+ *  with ezLCD_bus_claim().
+ */
+void ezLCD_event_tick(void);
+
+/** Keeps ezLCD_event_tick() off the bus until ezLCD_bus_release(), so a
+ *  command and the reply read back with separate ezLCD_transfer_data()
+ *  calls, such as PING, are not split by a no-op poll.
+ */
+void ezLCD_bus_claim(void);
+
+/** Ends a claim made with ezLCD_bus_claim() */
+void ezLCD_bus_release(void);
+
 #endif /* EZLCD_COMMON_H */
 /** @} */ /* ezLCD_103_common */
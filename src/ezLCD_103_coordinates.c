@@ -20,36 +20,37 @@
 /*----------------------------------------------------------------------------*/
 void ezLCD_set_xy(int16_t x, int16_t y)
 {
- ezLCD_transfer_data_long(0x33,0);
- ezLCD_transfer_data_long(x >> 8,0);
- ezLCD_transfer_data_long(x & 0xFF,0);
- ezLCD_transfer_data_long(y >> 8,0);
- ezLCD_transfer_data_long(y & 0xFF,1);
+ ezLCD_cmd_put(0x33);
+ ezLCD_cmd_put16(x);
+ ezLCD_cmd_put16(y);
+ ezLCD_cmd_flush();
 }
 
 void ezLCD_set_x(int16_t x)
 {
- ezLCD_transfer_data_long(0x6E,0);
- ezLCD_transfer_data_long(x >> 8,0);
- ezLCD_transfer_data_long(x & 0xFF,1);
+ ezLCD_cmd_put(0x6E);
+ ezLCD_cmd_put16(x);
+ ezLCD_cmd_flush();
 }
 
 void ezLCD_set_y(int16_t y)
 {
- ezLCD_transfer_data_long(0x6F,0);
- ezLCD_transfer_data_long(y >> 8,0);
- ezLCD_transfer_data_long(y & 0xFF,1);
+ ezLCD_cmd_put(0x6F);
+ ezLCD_cmd_put16(y);
+ ezLCD_cmd_flush();
 }
 
 void ezLCD_save_position(uint8_t index)
 {
- ezLCD_transfer_data_long(0x35,0);
- ezLCD_transfer_data_long(index,1);
+ ezLCD_cmd_put(0x35);
+ ezLCD_cmd_put(index);
+ ezLCD_cmd_flush();
 }
 
 void ezLCD_restore_position(uint8_t index)
 {
- ezLCD_transfer_data_long(0x36,0);
- ezLCD_transfer_data_long(index,1);
+ ezLCD_cmd_put(0x36);
+ ezLCD_cmd_put(index);
+ ezLCD_cmd_flush();
 }
 /** @} */ /* ezLCD_103_coordinates */
\ No newline at end of file
@@ -0,0 +1,135 @@
+/*
+ * @file   ezLCD_103_display_list.c  <br>
+ * @author agent <br>
+ * @date   October 2026  <br>
+ * @brief  ezLCD display list recording and replay source file  <br>
+ * @defgroup ezLCD_103_display_list Display Lists
+ * @{
+ *
+ * This source contains functions used to record and replay display lists.
+ * Recording takes 9 bytes of RAM besides the caller's buffer; the shadow
+ * state is invalidated around it rather than saved, so no copy of it is kept.
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include "ezLCD_103_common.h"
+#include "ezLCD_103_display_list.h"
+
+/*----------------------------------------------------------------------------*/
+/* CONSTANTS                                                                  */
+/*----------------------------------------------------------------------------*/
+#define RECORD_LENGTH    0x7F    /* Header bits holding the byte count */
+#define RECORD_CONTINUES 0x80    /* Header bit: next record, same command */
+#define NO_RECORD        0xFFFF  /* No record is open */
+
+/*----------------------------------------------------------------------------*/
+/* VARIABLES                                                                  */
+/*----------------------------------------------------------------------------*/
+static uint8_t  *list_buffer;     /* List being recorded */
+static uint16_t list_size;        /* Size of list_buffer */
+static uint16_t list_length;      /* Bytes recorded so far */
+static uint16_t list_header;      /* Index of the open record's header */
+static uint8_t  list_overflow;    /* list_buffer was too small */
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+/* Receives the staged bytes of every command while recording */
+static void ezLCD_display_list_sink(const uint8_t *data,
+                                    uint8_t length,
+                                    uint8_t end)
+{
+  for(; length != 0; --length)
+  {
+    /* Open a record if none is open or the open one is full, leaving room
+     * for this byte and the terminator */
+    if(list_header == NO_RECORD ||
+       (list_buffer[list_header] & RECORD_LENGTH) == RECORD_LENGTH)
+    {
+      if(list_length + 3 > list_size)
+      {
+        list_overflow = 1;
+        return;
+      }
+      
+      if(list_header != NO_RECORD)
+        list_buffer[list_header] |= RECORD_CONTINUES;
+      
+      list_header = list_length;
+      list_buffer[list_length++] = 0;
+    }
+    else if(list_length + 2 > list_size)
+    {
+      list_overflow = 1;
+      return;
+    }
+    
+    list_buffer[list_length++] = *data++;
+    ++list_buffer[list_header];
+  }
+  
+  if(end)
+    list_header = NO_RECORD;
+}
+
+void ezLCD_display_list_begin(uint8_t *buffer, uint16_t size)
+{
+  list_buffer   = buffer;
+  list_size     = size;
+  list_length   = 0;
+  list_header   = NO_RECORD;
+  list_overflow = (size == 0);
+  
+  ezLCD_state_invalidate();
+  
+  ezLCD_cmd_redirect(ezLCD_display_list_sink);
+}
+
+uint16_t ezLCD_display_list_end(void)
+{
+  ezLCD_cmd_redirect(0);
+  
+  /* The shadow now describes the recorded commands, not the display */
+  ezLCD_state_invalidate();
+  
+  if(list_overflow)
+    return 0;
+  
+  list_buffer[list_length++] = 0;              /* Terminator */
+  return list_length;
+}
+
+void ezLCD_display_list_play(const uint8_t *list)
+{
+  uint8_t header;
+  uint8_t length;
+  
+  while((header = *list++) != 0)
+  {
+    length = header & RECORD_LENGTH;
+    ezLCD_cmd_write(list, length, !(header & RECORD_CONTINUES));
+    list += length;
+  }
+  
+  /* The list changed the display's settings behind the setters' backs */
+  ezLCD_state_invalidate();
+}
+
+void ezLCD_display_list_play_flash(const EZLCD_FLASH uint8_t *list)
+{
+  uint8_t header;
+  uint8_t length;
+  
+  while((header = *list++) != 0)
+  {
+    length = header & RECORD_LENGTH;
+    ezLCD_cmd_write_flash(list, length, !(header & RECORD_CONTINUES));
+    list += length;
+  }
+  
+  /* The list changed the display's settings behind the setters' backs */
+  ezLCD_state_invalidate();
+}
+/** @} */ /* ezLCD_103_display_list */
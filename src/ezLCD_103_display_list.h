@@ -0,0 +1,207 @@
+/**
+ * @file   ezLCD_103_display_list.h  <br>
+ * @author agent <br>
+ * @date   October 2026  <br>
+ * @brief  ezLCD display list recording and replay header file  <br>
+ * @defgroup ezLCD_103_display_list Display Lists
+ * @{
+ *
+ * This header contains functions used to record a sequence of ezLCD_* calls
+ * into a byte buffer (a display list) and to send that sequence again later
+ * with a single call. Replaying a list does none of the work the original
+ * calls did: the commands are already encoded, so the bytes go straight from
+ * the list onto the SPI bus and a page costs exactly its wire time.
+ *
+ * A typical use is to record a page once at start-up and replay it every time
+ * the page is shown:
+ *
+ * @code
+    static uint8_t start_page[300];
+    
+    ezLCD_display_list_begin(start_page, sizeof(start_page));
+    ezLCD_set_xy(0,0);
+    ezLCD_put_picture_rom(BACKGROUND_1_INDEX);
+    draw_buttons();
+    if(!ezLCD_display_list_end())
+      ... the buffer was too small ...
+    
+    ezLCD_display_list_play(start_page);
+   @endcode
+ *
+ * Lists may also live in flash (see ezLCD_display_list_play_flash()). The
+ * format of a list is a series of records, each made of a header byte and the
+ * command bytes that follow it:
+ *
+ * - Bits 0-6 of the header hold the number of command bytes, 1 to 127.
+ * - Bit 7 of the header is set when the next record continues the same 
+ *   command, so the display stays selected between the two.
+ * - A header of 0 ends the list.
+ *
+ * Since the format is this simple, a static screen whose contents are all
+ * compile-time constants does not need to be recorded at all. The
+ * EZLCD_LIST_* macros below expand to the records of one command each, so the
+ * list can be written out as a constant table which the compiler places in
+ * flash. No code is generated for the commands and the table is streamed by
+ * ezLCD_display_list_play_flash():
+ *
+ * @code
+    static const EZLCD_FLASH uint8_t stop_page[] =
+    {
+      EZLCD_LIST_DRAW_FRAME(1),
+      EZLCD_LIST_DEACTIVATE_ALL_BUTTONS(),
+      EZLCD_LIST_XY(0, 0),
+      EZLCD_LIST_PICTURE_ROM(BACKGROUND_1_INDEX),
+      EZLCD_LIST_BUTTON(START, EZLCD_BUTTON_UP, ..., 215, 5, 100, 50),
+      EZLCD_LIST_DISPLAY_FRAME(1),
+      EZLCD_LIST_END
+    };
+    
+    ezLCD_display_list_play_flash(stop_page);
+   @endcode
+ *
+ * While recording, nothing is sent to the display, so only functions which
+ * send commands without reading a reply may be recorded. ezLCD_ping(),
+ * ezLCD_calibrate_screen(), ezLCD_wait_for_event() and ezLCD_poll_event()
+ * talk to the display directly even while recording. Functions which also
+ * keep state in the driver, such as ezLCD_init_putchar(), update that state
+ * when they are recorded and not when the list is replayed.
+ */
+#ifndef EZLCD_DISPLAY_LIST_H
+#define EZLCD_DISPLAY_LIST_H
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include "ezLCD_103_common.h"
+
+/*----------------------------------------------------------------------------*/
+/* MACROS                                                                     */
+/*----------------------------------------------------------------------------*/
+/** A 16-bit parameter, most significant byte first */
+#define EZLCD_LIST_WORD(value)     (uint8_t)((uint16_t)(value) >> 8),         \
+                                   (uint8_t)(value)
+
+/** Ends a list */
+#define EZLCD_LIST_END             0
+
+/** Same as ezLCD_set_color_rgb(). @a rgb is one of the color macros of
+ *  ezLCD_103_colors.h, such as EZLCD_WHITE. */
+#define EZLCD_LIST_COLOR(rgb)      4, 0x31, rgb
+
+/** Same as ezLCD_set_xy() */
+#define EZLCD_LIST_XY(x, y)        5, 0x33, EZLCD_LIST_WORD(x),               \
+                                   EZLCD_LIST_WORD(y)
+
+/** Same as ezLCD_draw_rect() */
+#define EZLCD_LIST_RECT(x2, y2)    5, 0xA4, EZLCD_LIST_WORD(x2),              \
+                                   EZLCD_LIST_WORD(y2)
+
+/** Same as ezLCD_draw_rect_fill() */
+#define EZLCD_LIST_RECT_FILL(x2, y2)                                          \
+                                   5, 0xA5, EZLCD_LIST_WORD(x2),              \
+                                   EZLCD_LIST_WORD(y2)
+
+/** Same as ezLCD_put_picture_rom() */
+#define EZLCD_LIST_PICTURE_ROM(picture_number)                                \
+                                   3, 0x59, EZLCD_LIST_WORD(picture_number)
+
+/** Same as ezLCD_set_true_type_font() */
+#define EZLCD_LIST_TRUE_TYPE_FONT(font_number, height, width)                 \
+                                   4, 0x91, font_number, height, width
+
+/** Same as ezLCD_putchar() */
+#define EZLCD_LIST_CHAR(c)         2, 0x2C, c
+
+/** PRINT_STRING, the command ezLCD_puts() sends for each line of text after
+ *  placing the cursor. A macro cannot split a string literal into bytes, so
+ *  the characters follow the macro one by one and end with a 0, and
+ *  @a length gives their number, at most 125:
+ *
+ * @code
+    EZLCD_LIST_XY(7, 7),
+    EZLCD_LIST_STRING(2), 'H', 'i', 0,
+   @endcode
+ */
+#define EZLCD_LIST_STRING(length)  (length) + 2, 0x2D
+
+/** Same as ezLCD_set_draw_frame() */
+#define EZLCD_LIST_DRAW_FRAME(frame)                                          \
+                                   2, 0x51, frame
+
+/** Same as ezLCD_set_display_frame() */
+#define EZLCD_LIST_DISPLAY_FRAME(frame)                                       \
+                                   2, 0x52, frame
+
+/** Same as ezLCD_deactivate_all_buttons() */
+#define EZLCD_LIST_DEACTIVATE_ALL_BUTTONS()                                   \
+                                   1, 0xB4
+
+/** Same as ezLCD_button_define_long() */
+#define EZLCD_LIST_BUTTON(id, state, index_up, index_down, index_disabled,    \
+                          x, y, width, height)                                \
+                                   15, 0xB5, id, state,                       \
+                                   EZLCD_LIST_WORD(index_up),                 \
+                                   EZLCD_LIST_WORD(index_down),               \
+                                   EZLCD_LIST_WORD(index_disabled),           \
+                                   EZLCD_LIST_WORD(x),                        \
+                                   EZLCD_LIST_WORD(y),                        \
+                                   width, height
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+/** Starts recording every following command into @a buffer instead of sending
+ *  it to the display. The driver's shadow state (see ezLCD_state) is
+ *  invalidated when recording starts, so the first setter of each kind is
+ *  recorded in full and the list does not depend on what the display held
+ *  when it was recorded.
+ *
+ *  @par Parameters
+ *       - @a buffer = Where the list is stored.
+ *       - @a size   = Size of @a buffer in bytes.
+ *
+ *  @par Assumptions
+ *       - No other list is being recorded.
+ *       - No command is half staged with ezLCD_cmd_put().
+ */
+void ezLCD_display_list_begin(uint8_t *buffer, uint16_t size);
+
+/** Stops recording and sends commands to the display again. The shadow state
+ *  is left invalid, as after a replay, so the first setter of each kind and
+ *  the next ezLCD_button_page() are sent in full.
+ *
+ *  @returns The length of the list in bytes including its terminator, or 0 if
+ *           the buffer was too small and the list is unusable.
+ */
+uint16_t ezLCD_display_list_end(void);
+
+/** Sends a list recorded with ezLCD_display_list_begin(), keeping the chip
+ *  select framing of the original calls.
+ *
+ *  @par Parameters
+ *       - @a list = The list to send.
+ *
+ *  @par Assumptions
+ *       - No command is half staged with ezLCD_cmd_put().
+ *       - The user has initialized the MCU's SPI interface with the
+ *         EZLCD_INIT_SPI() macro.
+ *       - The user has set the MCU's SPI pins to inputs and outputs 
+ *         appropriately. <BR><BR>
+ *         - SS_BAR = OUTPUT
+ *         - SCK    = OUTPUT
+ *         - MOSI   = OUTPUT
+ *         - MISO   = INPUT
+ */
+void ezLCD_display_list_play(const uint8_t *list);
+
+/** Same as ezLCD_display_list_play() for a list stored in flash.
+ *
+ *  @par Parameters
+ *       - @a list = The list to send.
+ *
+ *  @par Assumptions
+ *       - Same as ezLCD_display_list_play().
+ */
+void ezLCD_display_list_play_flash(const EZLCD_FLASH uint8_t *list);
+
+#endif /* EZLCD_DISPLAY_LIST_H */
+/** @} */ /* ezLCD_103_display_list */
@@ -44,6 +44,8 @@
 #include "ezLCD_103_frames.h"
 #include "ezLCD_103_images.h"
 #include "ezLCD_103_system.h"
+#include "ezLCD_103_display_list.h"
+#include "ezLCD_103_touch.h"
 
 #endif /* EZLCD_103_DRIVER_ATMEGA128_H */
 /** @} */ /* ezLCD_103_driver */
\ No newline at end of file
@@ -21,19 +21,22 @@
 /*----------------------------------------------------------------------------*/
 void ezLCD_clear(void)
 {
- ezLCD_transfer_data(0x21);
+ ezLCD_cmd_put(0x21);
+ ezLCD_cmd_flush();
 }
 
 void ezLCD_fill(void)
 {
- ezLCD_transfer_data(0x9B);
+ ezLCD_cmd_put(0x9B);
+ ezLCD_cmd_flush();
 }
 
 void ezLCD_fill_bound(uint8_t red, uint8_t green, uint8_t blue)
 {
- ezLCD_transfer_data_long(0x9C,0);
- ezLCD_transfer_data_long(red,0);
- ezLCD_transfer_data_long(green,0);
- ezLCD_transfer_data_long(blue,1);
+ ezLCD_cmd_put(0x9C);
+ ezLCD_cmd_put(red);
+ ezLCD_cmd_put(green);
+ ezLCD_cmd_put(blue);
+ ezLCD_cmd_flush();
 }
 /** @} */ /* ezLCD_103_fill */
\ No newline at end of file
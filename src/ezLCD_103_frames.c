@@ -7,26 +7,168 @@
  * @{
  *
  * This source contains functions which are used to set the drawing and display
- * frames. 
+ * frames, to flip between a front and a back frame, and to keep pages in
+ * spare frames.
  */
  
 /*----------------------------------------------------------------------------*/
 /* INCLUDES                                                                   */
 /*----------------------------------------------------------------------------*/
 #include "ezLCD_103_common.h"
+#include "ezLCD_103_frames.h"
+
+/*----------------------------------------------------------------------------*/
+/* CONSTANTS                                                                  */
+/*----------------------------------------------------------------------------*/
+#if EZLCD_PAGE_FIRST_FRAME < 2
+#error "Frames 0 and 1 are the default front and back frames, not page frames"
+#endif
+
+/* 1 if @a frame is one of the frames holding pages */
+#define PAGE_FRAME(frame)  ((uint8_t)((frame) - EZLCD_PAGE_FIRST_FRAME) <    \
+                            EZLCD_PAGE_FRAMES)
+
+/*----------------------------------------------------------------------------*/
+/* VARIABLES                                                                  */
+/*----------------------------------------------------------------------------*/
+static uint8_t front_frame = 0;     /* Frame on the screen */
+static uint8_t back_frame  = 1;     /* Frame the next page is drawn on */
+
+static ezLCD_page_t *page_slot[EZLCD_PAGE_FRAMES]; /* Page in each frame */
+static uint8_t       page_age[EZLCD_PAGE_FRAMES];  /* Shows since last shown */
 
 /*----------------------------------------------------------------------------*/
 /* FUNCTIONS                                                                  */
 /*----------------------------------------------------------------------------*/
 void ezLCD_set_display_frame(uint8_t frame)
 {
- ezLCD_transfer_data_long(0x52,0);
- ezLCD_transfer_data_long(frame,1);
+ if(ezLCD_state_match(EZLCD_STATE_DISPLAY_FRAME, &ezLCD_state.display_frame,
+                      &frame, 1)) return;
+ 
+ ezLCD_cmd_put(0x52);
+ ezLCD_cmd_put(frame);
+ ezLCD_cmd_flush();
 }
 
 void ezLCD_set_draw_frame(uint8_t frame)
 {
- ezLCD_transfer_data_long(0x51,0);
- ezLCD_transfer_data_long(frame,1);
+ if(ezLCD_state_match(EZLCD_STATE_DRAW_FRAME, &ezLCD_state.draw_frame,
+                      &frame, 1)) return;
+ 
+ ezLCD_cmd_put(0x51);
+ ezLCD_cmd_put(frame);
+ ezLCD_cmd_flush();
+}
+
+void ezLCD_set_frame_pair(uint8_t front, uint8_t back)
+{
+ /* Presenting a page frame would show, then draw over, a kept page */
+ if(PAGE_FRAME(front) || PAGE_FRAME(back)) return;
+ 
+ front_frame = front;
+ back_frame  = back;
+}
+
+void ezLCD_begin_frame(void)
+{
+ ezLCD_set_draw_frame(back_frame);
+}
+
+void ezLCD_present(void)
+{
+ uint8_t frame = back_frame;
+ 
+ ezLCD_set_display_frame(frame);
+ 
+ /* Later drawing goes on the frame now shown until the next
+  * ezLCD_begin_frame(), so it is never lost on a hidden frame */
+ back_frame  = front_frame;
+ front_frame = frame;
+}
+
+uint8_t ezLCD_front_frame(void)
+{
+ return front_frame;
+}
+
+uint8_t ezLCD_back_frame(void)
+{
+ return back_frame;
+}
+
+/* Makes the page in @a slot the most recently used one */
+static void page_touch(uint8_t slot)
+{
+ uint8_t i;
+ 
+ for(i = 0; i < EZLCD_PAGE_FRAMES; ++i)
+   if(page_age[i] != 0xFF)
+     ++page_age[i];
+ page_age[slot] = 0;
+}
+
+void ezLCD_page_prepare(ezLCD_page_t *page)
+{
+ uint8_t slot;
+ uint8_t i;
+ uint8_t frame;
+ 
+ if(page->frame != EZLCD_PAGE_NONE)
+   return;
+ 
+ /* A free frame, or else the one shown least recently */
+ slot = 0;
+ for(i = 0; i < EZLCD_PAGE_FRAMES; ++i)
+ {
+   if(!page_slot[i])
+   {
+     slot = i;
+     break;
+   }
+   if(page_age[i] > page_age[slot])
+     slot = i;
+ }
+ 
+ if(page_slot[slot])
+   page_slot[slot]->frame = EZLCD_PAGE_NONE;
+ page_slot[slot] = page;
+ page->frame     = EZLCD_PAGE_FIRST_FRAME + slot;
+ page_touch(slot);
+ 
+ /* Drawing goes back where it was, so the frame only ever holds what
+  * page->draw() put there */
+ frame = (ezLCD_state.valid & EZLCD_STATE_DRAW_FRAME)
+       ? ezLCD_state.draw_frame : front_frame;
+ ezLCD_set_draw_frame(page->frame);
+ page->draw();
+ ezLCD_set_draw_frame(frame);
+}
+
+void ezLCD_page_show(ezLCD_page_t *page)
+{
+ ezLCD_page_prepare(page);
+ page_touch(page->frame - EZLCD_PAGE_FIRST_FRAME);
+ ezLCD_set_display_frame(page->frame);
+}
+
+void ezLCD_page_invalidate(ezLCD_page_t *page)
+{
+ if(page->frame == EZLCD_PAGE_NONE)
+   return;
+ 
+ page_slot[page->frame - EZLCD_PAGE_FIRST_FRAME] = 0;
+ page->frame = EZLCD_PAGE_NONE;
+}
+
+void ezLCD_page_invalidate_all(void)
+{
+ uint8_t i;
+ 
+ for(i = 0; i < EZLCD_PAGE_FRAMES; ++i)
+ {
+   if(page_slot[i])
+     page_slot[i]->frame = EZLCD_PAGE_NONE;
+   page_slot[i] = 0;
+ }
 }
 /** @} */ /* ezLCD_103_frames */
\ No newline at end of file
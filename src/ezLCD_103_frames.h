@@ -20,6 +20,55 @@
  *
  * @image html frames.png "Block diagram of the framing system"
  *
+ * For tear-free page changes the driver can manage two of these frames as a
+ * front frame, on the screen, and a back frame. ezLCD_begin_frame() directs
+ * drawing to the back frame and ezLCD_present() shows it, after which the two
+ * swap roles:
+ *
+ * @code
+    ezLCD_begin_frame();
+    ezLCD_set_xy(0,0);
+    ezLCD_put_picture_rom(BACKGROUND_1_INDEX);
+    ...
+    ezLCD_present();
+   @endcode
+ *
+ * A page costs the same 0x51 and 0x52 commands as selecting the frames by
+ * hand, and neither is sent when the frame is already selected. Between
+ * ezLCD_present() and the next ezLCD_begin_frame() drawing goes to the frame
+ * on the screen, so small updates such as text can be drawn in place. The
+ * back frame still holds the page before last, so a page drawn with
+ * ezLCD_begin_frame() must repaint everything that changed since then,
+ * typically by starting with its background.
+ *
+ * Pages which are shown again and again can instead be kept in spare frames.
+ * A page is described by the function which draws it; ezLCD_page_show()
+ * draws it into a frame of its own the first time and afterwards only
+ * selects that frame again:
+ *
+ * @code
+    static void draw_settings(void)
+    {
+      ezLCD_set_xy(0,0);
+      ezLCD_put_picture_rom(BACKGROUND_1_INDEX);
+      ...
+    }
+    static ezLCD_page_t settings = EZLCD_PAGE(draw_settings);
+    
+    ezLCD_page_show(&settings);
+   @endcode
+ *
+ * EZLCD_PAGE_FRAMES pages are kept at a time; when another one is needed the
+ * page shown least recently gives up its frame. A page whose contents
+ * change must be redrawn with ezLCD_page_invalidate().
+ *
+ * A page frame only ever holds what the page's draw function put there:
+ * drawing goes back to the frame it was on once the page is drawn, so it is
+ * not seen while the page is shown. A screen with text or other contents
+ * that change belongs on the front and back frames instead, and the next
+ * ezLCD_present() replaces any page on the screen. The page frames are kept
+ * out of that pair, see ezLCD_set_frame_pair().
+ *
  */
 #ifndef FRAMES_H
 #define FRAMES_H
@@ -28,6 +77,27 @@
 /*----------------------------------------------------------------------------*/
 #include "ezLCD_103_common.h"
 
+/*----------------------------------------------------------------------------*/
+/* TYPES                                                                      */
+/*----------------------------------------------------------------------------*/
+/** A page kept in a frame by ezLCD_page_show(). Declare it with EZLCD_PAGE()
+ *  and leave @a frame to the driver.
+ */
+typedef struct
+{
+  void    (*draw)(void);  /**< Draws the page on the current drawing frame */
+  uint8_t frame;          /**< Frame holding the page, or EZLCD_PAGE_NONE */
+} ezLCD_page_t;
+
+/*----------------------------------------------------------------------------*/
+/* MACROS                                                                     */
+/*----------------------------------------------------------------------------*/
+/** ezLCD_page_t::frame of a page which is not in any frame */
+#define EZLCD_PAGE_NONE   0xFF
+
+/** Initializer of an ezLCD_page_t drawn by @a draw */
+#define EZLCD_PAGE(draw)  { draw, EZLCD_PAGE_NONE }
+
 /*----------------------------------------------------------------------------*/
 /* FUNCTIONS                                                                  */
 /*----------------------------------------------------------------------------*/
@@ -68,5 +138,77 @@ void ezLCD_set_display_frame(uint8_t frame);
  */ 
 void ezLCD_set_draw_frame(uint8_t frame);
 
+/** Chooses the two frames ezLCD_begin_frame() and ezLCD_present() alternate.
+ *  The default is frame 0 in front and frame 1 at the back, which matches
+ *  the display at power up. A pair which includes one of the frames holding
+ *  pages (EZLCD_PAGE_FRAMES from EZLCD_PAGE_FIRST_FRAME on) is ignored.
+ *
+ *  @par Parameters
+ *       - front = The frame on the screen now, in the set of [0,19].
+ *       - back  = The frame to draw the next page on, in the set of [0,19].
+ */
+void ezLCD_set_frame_pair(uint8_t front, uint8_t back);
+
+/** Directs drawing to the back frame, where a page can be built without
+ *  being seen. See ezLCD_set_draw_frame() for the assumptions.
+ */
+void ezLCD_begin_frame(void);
+
+/** Shows the back frame and swaps the roles of the two frames. Drawing
+ *  continues on the frame now shown. See ezLCD_set_display_frame() for the
+ *  assumptions.
+ */
+void ezLCD_present(void);
+
+/** @returns The frame on the screen. */
+uint8_t ezLCD_front_frame(void);
+
+/** @returns The frame the next ezLCD_begin_frame() draws on. */
+uint8_t ezLCD_back_frame(void);
+
+/** Draws a page into a frame of its own, unless it is there already, without
+ *  showing it. Useful at start-up so the first switch to each page is as
+ *  fast as the later ones. Drawing goes back to the frame it was on, or to
+ *  the front frame if that is not known.
+ *
+ *  @par Parameters
+ *       - page = The page.
+ *
+ *  @par Assumptions
+ *       - Same as ezLCD_set_draw_frame().
+ */
+void ezLCD_page_prepare(ezLCD_page_t *page);
+
+/** Shows a page. If it is already in a frame, this selects that frame for
+ *  display and nothing else; otherwise the page is first drawn into a frame,
+ *  taken from the page shown least recently if none is free, as
+ *  ezLCD_page_prepare() does. Drawing is left on the frame it was on, so
+ *  nothing drawn later ends up in the kept page.
+ *
+ *  Buttons are not part of a frame: a page which has buttons should call
+ *  ezLCD_button_page() with @a repaint set while drawing, and again with
+ *  @a repaint clear after each ezLCD_page_show() to make them active.
+ *
+ *  @par Parameters
+ *       - page = The page.
+ *
+ *  @par Assumptions
+ *       - Same as ezLCD_set_display_frame().
+ */
+void ezLCD_page_show(ezLCD_page_t *page);
+
+/** Gives up the frame of a page, so the next ezLCD_page_show() or
+ *  ezLCD_page_prepare() draws it again.
+ *
+ *  @par Parameters
+ *       - page = The page.
+ */
+void ezLCD_page_invalidate(ezLCD_page_t *page);
+
+/** Gives up the frames of all pages, e.g. after the display has been
+ *  switched off and on.
+ */
+void ezLCD_page_invalidate_all(void);
+
 #endif /* FRAMES_H */
 /** @} */ /* ezLCD_103_frames */
\ No newline at end of file
@@ -20,21 +20,21 @@
 /*----------------------------------------------------------------------------*/
 void ezLCD_put_picture_rom(uint16_t picture_number)
 {
- ezLCD_transfer_data_long(0x59,0);
- ezLCD_transfer_data_long(picture_number >> 8,0);
- ezLCD_transfer_data_long(picture_number & 0xFF,1);
+ ezLCD_cmd_put(0x59);
+ ezLCD_cmd_put16(picture_number);
+ ezLCD_cmd_flush();
 }
 
 void ezLCD_put_picture_sd(char file_path[], uint8_t length)
 {
  uint8_t i;
  
- ezLCD_transfer_data_long(0x70,0);
+ ezLCD_cmd_put(0x70);
  
  for(i=0; i < length; ++i)
-   ezLCD_transfer_data_long(file_path[i],0);
- 
- ezLCD_transfer_data_long(0x00,0);
+   ezLCD_cmd_put(file_path[i]);
  
+ ezLCD_cmd_put(0x00);
+ ezLCD_cmd_flush();
 }
 /** @} */ /* ezLCD_103_images */
@@ -22,24 +22,23 @@
 /*----------------------------------------------------------------------------*/
 void ezLCD_draw_line(int16_t x, int16_t y)
 {
- ezLCD_transfer_data_long(0x3F,0);
- ezLCD_transfer_data_long(x >> 8,0);
- ezLCD_transfer_data_long(x & 0xFF,0);
- ezLCD_transfer_data_long(y >> 8,0);
- ezLCD_transfer_data_long(y & 0xFF,1);
+ ezLCD_cmd_put(0x3F);
+ ezLCD_cmd_put16(x);
+ ezLCD_cmd_put16(y);
+ ezLCD_cmd_flush();
 }
 
 void ezLCD_draw_h_line(int16_t x)
 {
- ezLCD_transfer_data_long(0xA0,0);
- ezLCD_transfer_data_long(x >> 8,0);
- ezLCD_transfer_data_long(x & 0xFF,1);
+ ezLCD_cmd_put(0xA0);
+ ezLCD_cmd_put16(x);
+ ezLCD_cmd_flush();
 }
 
 void ezLCD_draw_v_line(int16_t y)
 {
- ezLCD_transfer_data_long(0xA1,0);
- ezLCD_transfer_data_long(y >> 8,0);
- ezLCD_transfer_data_long(y & 0xFF,1);
+ ezLCD_cmd_put(0xA1);
+ ezLCD_cmd_put16(y);
+ ezLCD_cmd_flush();
 }
 /** @} */ /* ezLCD_103_lines */
\ No newline at end of file
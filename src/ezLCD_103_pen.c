@@ -22,13 +22,20 @@
 /*----------------------------------------------------------------------------*/
 void ezLCD_set_pen_size(uint8_t size)
 {
- ezLCD_transfer_data_long(0x81,0);
- ezLCD_transfer_data_long(size,1);
+ if(ezLCD_state_match(EZLCD_STATE_PEN, &ezLCD_state.pen, &size, 1)) return;
+ 
+ ezLCD_cmd_put(0x81);
+ ezLCD_cmd_put(size);
+ ezLCD_cmd_flush();
 }
 
 void ezLCD_set_pen_height(uint8_t height)
 {
- ezLCD_transfer_data_long(0x82,0);
- ezLCD_transfer_data_long(height,1);
+ /* The pen is no longer square, so the next pen size must be sent */
+ ezLCD_state.valid &= ~EZLCD_STATE_PEN;
+ 
+ ezLCD_cmd_put(0x82);
+ ezLCD_cmd_put(height);
+ ezLCD_cmd_flush();
 }
 /** @} */ /* ezLCD_103_pen */
\ No newline at end of file
@@ -21,15 +21,15 @@
 /*----------------------------------------------------------------------------*/
 void ezLCD_set_plot_pixel(void)
 {
- ezLCD_transfer_data(0x26);
+ ezLCD_cmd_put(0x26);
+ ezLCD_cmd_flush();
 }
 
 void ezLCD_set_plot_pixel_xy(uint16_t x, uint16_t y)
 {
- ezLCD_transfer_data_long(0x3E,0);
- ezLCD_transfer_data_long(x >> 8,0);
- ezLCD_transfer_data_long(x & 0xFF,0);
- ezLCD_transfer_data_long(y >> 8,0);
- ezLCD_transfer_data_long(y & 0xFF,1);
+ ezLCD_cmd_put(0x3E);
+ ezLCD_cmd_put16(x);
+ ezLCD_cmd_put16(y);
+ ezLCD_cmd_flush();
 }
 /** @} */ /* ezLCD_103_pixels */
\ No newline at end of file
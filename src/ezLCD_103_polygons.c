@@ -23,20 +23,18 @@
 /*----------------------------------------------------------------------------*/
 void ezLCD_draw_rect(uint16_t x2, uint16_t y2)
 {
- ezLCD_transfer_data_long(0xA4,0);
- ezLCD_transfer_data_long(x2 >> 8,0);
- ezLCD_transfer_data_long(x2 & 0xFF,0);
- ezLCD_transfer_data_long(y2 >> 8,0);
- ezLCD_transfer_data_long(y2 & 0xFF,1);
+ ezLCD_cmd_put(0xA4);
+ ezLCD_cmd_put16(x2);
+ ezLCD_cmd_put16(y2);
+ ezLCD_cmd_flush();
 }
 
 void ezLCD_draw_rect_fill(uint16_t x2, uint16_t y2)
 {
- ezLCD_transfer_data_long(0xA5,0);
- ezLCD_transfer_data_long(x2 >> 8,0);
- ezLCD_transfer_data_long(x2 & 0xFF,0);
- ezLCD_transfer_data_long(y2 >> 8,0);
- ezLCD_transfer_data_long(y2 & 0xFF,1);
+ ezLCD_cmd_put(0xA5);
+ ezLCD_cmd_put16(x2);
+ ezLCD_cmd_put16(y2);
+ ezLCD_cmd_flush();
 }
 
  //n = 2 to 255 (n sould be 1 less than total # of verticies, current pos is 
@@ -44,23 +42,17 @@ void ezLCD_draw_rect_fill(uint16_t x2, uint16_t y2)
 void ezLCD_draw_polygon(uint8_t n, uint16_t x[], uint16_t y[])
 {
   uint8_t i;
-  uint8_t j = n-1;
    
-  ezLCD_transfer_data_long(0xA6,0); /* Send command */ 
-  ezLCD_transfer_data_long(n,0);    /* Send number of verticies */ 
+  ezLCD_cmd_put(0xA6); /* Send command */ 
+  ezLCD_cmd_put(n);    /* Send number of verticies */ 
   
-  for(i = 0; i < j; ++i)
+  for(i = 0; i < n; ++i)
   {
-    ezLCD_transfer_data_long(x[i] >> 8,0);
-    ezLCD_transfer_data_long(x[i] & 0xFF,0);
-    ezLCD_transfer_data_long(y[i] >> 8,0);
-    ezLCD_transfer_data_long(y[i] & 0xFF,0);
+    ezLCD_cmd_put16(x[i]);
+    ezLCD_cmd_put16(y[i]);
   }
   
-    ezLCD_transfer_data_long(x[j] >> 8,0);
-    ezLCD_transfer_data_long(x[j] & 0xFF,0);
-    ezLCD_transfer_data_long(y[j] >> 8,0);
-    ezLCD_transfer_data_long(y[j] & 0xFF,1);
+  ezLCD_cmd_flush();          /* Send the whole polygon under one select */
 }
 
 void ezLCD_set_edit_rectangle(int16_t x,
@@ -68,16 +60,13 @@ void ezLCD_set_edit_rectangle(int16_t x,
                               uint16_t width,
                               uint16_t height)
 {
-    ezLCD_transfer_data_long(0x5C,0);
+    ezLCD_cmd_put(0x5C);
     
-    ezLCD_transfer_data_long(x >> 8,0);
-    ezLCD_transfer_data_long(x & 0xFF,0);
-    ezLCD_transfer_data_long(y >> 8,0);
-    ezLCD_transfer_data_long(y & 0xFF,0);
+    ezLCD_cmd_put16(x);
+    ezLCD_cmd_put16(y);
     
-    ezLCD_transfer_data_long(width >> 8,0);
-    ezLCD_transfer_data_long(width & 0xFF,0);
-    ezLCD_transfer_data_long(height >> 8,0);
-    ezLCD_transfer_data_long(height & 0xFF,0);
+    ezLCD_cmd_put16(width);
+    ezLCD_cmd_put16(height);
+    ezLCD_cmd_flush();
 }                             
 /** @} */ /* ezLCD_103_polygons */
\ No newline at end of file
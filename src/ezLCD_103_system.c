@@ -24,26 +24,31 @@
 
 void ezLCD_backlight_on(void)
 {
-  ezLCD_transfer_data(0x22);
+  ezLCD_cmd_put(0x22);
+  ezLCD_cmd_flush();
 }
 
 void ezLCD_backlight_off(void)
 {
-  ezLCD_transfer_data(0x23);
+  ezLCD_cmd_put(0x23);
+  ezLCD_cmd_flush();
 }
 
 void ezLCD_set_brightness(uint8_t brightness)
 {
-  ezLCD_transfer_data_long(0x80,0);
-  ezLCD_transfer_data_long(brightness,1);
+  ezLCD_cmd_put(0x80);
+  ezLCD_cmd_put(brightness);
+  ezLCD_cmd_flush();
 }
 
 uint8_t ezLCD_ping()
 {
   uint8_t pong;
   
+  ezLCD_bus_claim();                 /* The reply must not go to a touch poll */
   ezLCD_transfer_data(0x83);
   pong = ezLCD_transfer_data(0x00);
+  ezLCD_bus_release();
   
   if(pong == 0x38) return 1;
   else return 0;
@@ -23,10 +23,12 @@
 /*----------------------------------------------------------------------------*/
 /* MACROS                                                                     */
 /*----------------------------------------------------------------------------*/
-/** Used to turn the ezLCD+103 on */
-#define EZLCD_POWER_ON()  SETBIT(EZLCD_POWER_PORT,EZLCD_POWER_PIN);
+/** Used to turn the ezLCD+103 on. The display starts with unknown settings, so
+ *  the driver's shadow state is invalidated as well. */
+#define EZLCD_POWER_ON()  do { SETBIT(EZLCD_POWER_PORT,EZLCD_POWER_PIN);      \
+                               ezLCD_state_invalidate(); } while(0)
 /** Used to turn the ezLCD+103 off */
-#define EZLCD_POWER_OFF() CLEARBIT(EZLCD_POWER_PORT,EZLCD_POWER_PIN);
+#define EZLCD_POWER_OFF() CLEARBIT(EZLCD_POWER_PORT,EZLCD_POWER_PIN)
 
 /*----------------------------------------------------------------------------*/
 /* FUNCTIONS                                                                  */
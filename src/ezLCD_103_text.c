@@ -16,14 +16,30 @@
 #include "ezLCD_103_coordinates.h"
 #include "ezLCD_103_polygons.h"
 #include "ezLCD_103_colors.h"
+#include "ezLCD_103_text.h"
 
 /*----------------------------------------------------------------------------*/
 /* FUNCTIONS                                                                  */
 /*----------------------------------------------------------------------------*/
 void ezLCD_set_bitmap_font(uint8_t font_number)
 {
-  ezLCD_transfer_data_long(0x2B,0);
-  ezLCD_transfer_data_long(font_number,1);
+  uint8_t font[4];
+  
+  font[0] = 0x2B;
+  font[1] = font_number;
+  font[2] = 0;
+  font[3] = 0;
+  if(ezLCD_state_match(EZLCD_STATE_FONT, ezLCD_state.font, font, 4)) return;
+  
+  /* Buffered text belongs to the old font */
+  ezLCD_putchar_flush();
+  
+  /* Do not assume the Unicode base survives a font change */
+  ezLCD_state.valid &= ~EZLCD_STATE_UNICODE_BASE;
+  
+  ezLCD_cmd_put(0x2B);
+  ezLCD_cmd_put(font_number);
+  ezLCD_cmd_flush();
 }
 
 //width == 0 -> calculate width automatically
@@ -31,17 +47,42 @@ void ezLCD_set_true_type_font(uint8_t font_number,
                               uint8_t height,
                               uint8_t width)
 {
-    ezLCD_transfer_data_long(0x91,0);
-    ezLCD_transfer_data_long(font_number,0);
-    ezLCD_transfer_data_long(height,0);
-    ezLCD_transfer_data_long(width,1);
+    uint8_t font[4];
+    
+    font[0] = 0x91;
+    font[1] = font_number;
+    font[2] = height;
+    font[3] = width;
+    if(ezLCD_state_match(EZLCD_STATE_FONT, ezLCD_state.font, font, 4)) return;
+    
+    /* Buffered text belongs to the old font */
+    ezLCD_putchar_flush();
+    
+    /* Do not assume the Unicode base survives a font change */
+    ezLCD_state.valid &= ~EZLCD_STATE_UNICODE_BASE;
+    
+    ezLCD_cmd_put(0x91);
+    ezLCD_cmd_put(font_number);
+    ezLCD_cmd_put(height);
+    ezLCD_cmd_put(width);
+    ezLCD_cmd_flush();
 }
 
 void ezLCD_set_ttf_unicode_base(uint16_t base)
 {
- ezLCD_transfer_data_long(0x93,0);
- ezLCD_transfer_data_long(base >> 8,0);
- ezLCD_transfer_data_long(base & 0xFF,0);
+ uint8_t msb_lsb[2];
+ 
+ msb_lsb[0] = base >> 8;
+ msb_lsb[1] = base & 0xFF;
+ if(ezLCD_state_match(EZLCD_STATE_UNICODE_BASE, ezLCD_state.unicode_base,
+                      msb_lsb, 2)) return;
+ 
+ /* Buffered text belongs to the old base */
+ ezLCD_putchar_flush();
+ 
+ ezLCD_cmd_put(0x93);
+ ezLCD_cmd_put16(base);
+ ezLCD_cmd_flush();
 }
 
 
@@ -64,6 +105,29 @@ static uint8_t text_r;
 static uint8_t text_g;
 static uint8_t text_b;
 
+/* Console mode, see ezLCD_console_begin() */
+static uint8_t  console_on;
+static char     console_text[EZLCD_CONSOLE_LINES][EZLCD_CONSOLE_COLUMNS];
+static uint8_t  console_length[EZLCD_CONSOLE_LINES];
+static uint16_t console_last;            /* Number of the line being written */
+static uint8_t  console_count;           /* Lines held, up to the ring size */
+static uint8_t  console_back;            /* Lines the view is scrolled back */
+static uint8_t  console_rows;
+static uint8_t  console_columns;
+static uint8_t  console_dirty;           /* Text changed since the refresh */
+static uint16_t console_ticks;           /* Least ticks between refreshes */
+static uint16_t console_stamp;           /* ezLCD_event_clock() of refresh */
+
+/* Buffered putchar(), see ezLCD_putchar_buffer() */
+static char     stdio_buffer[EZLCD_PUTCHAR_BUFFER_SIZE + 1];
+static uint8_t  stdio_length;
+static uint8_t  stdio_buffered;
+
+/* What each row of the text box shows: the first row_length characters of
+ * line row_line, still in the ring unless it has been overwritten since */
+static uint16_t row_line[EZLCD_CONSOLE_ROWS];
+static uint8_t  row_length[EZLCD_CONSOLE_ROWS];
+
 
 void ezLCD_init_putchar(uint16_t x,
                         uint16_t y,
@@ -80,6 +144,9 @@ void ezLCD_init_putchar(uint16_t x,
                         uint8_t text_green,
                         uint8_t text_blue)
 {
+  /* Text still buffered goes to the old text box */
+  ezLCD_putchar_flush();
+  
   /* Set XY coordinates of top-left corner of text box */
   text_box_x       = x;
   text_box_y       = y;
@@ -117,31 +184,35 @@ void ezLCD_init_putchar(uint16_t x,
   /* Initialize text color */
   ezLCD_set_color_rgb(text_r, text_g, text_b);
   
+  /* Plain text box until ezLCD_console_begin() */
+  console_on = 0;
 }
 
 
 void ezLCD_putchar(char c)
 {
- ezLCD_transfer_data_long(0x2C,0);
- ezLCD_transfer_data_long(c,1);
+ ezLCD_cmd_put(0x2C);
+ ezLCD_cmd_put(c);
+ ezLCD_cmd_flush();
 }
 
 void ezLCD_putchar_bg(char c)
 {
- ezLCD_transfer_data_long(0x3C,0);
- ezLCD_transfer_data_long(c,1);
+ ezLCD_cmd_put(0x3C);
+ ezLCD_cmd_put(c);
+ ezLCD_cmd_flush();
 }
 
-int putchar(int c)
+/* Moves the text box cursor to the start of the next line */
+static void text_box_line_feed(void)
+{
+  y_pos += font_h + 2;
+  x_pos  = text_box_x + box_bezel_width;
+}
+
+/* Clears the text box and starts from the top once the bottom is reached */
+static void text_box_wrap(void)
 {
-  ezLCD_set_color_rgb(text_r, text_g, text_b);
-  
-  if(x_pos >= (text_box_x + text_box_width + box_bezel_width - font_w) || c == '\n')
-  {
-    y_pos += font_h + 2;
-    x_pos  = text_box_x + box_bezel_width;
-  }
-  
   if((y_pos + font_h) >= (text_box_y + text_box_height - box_bezel_height))
   {
     /* Draw Text Box */
@@ -153,6 +224,421 @@ int putchar(int c)
     /* Reset Y coordinate */
     y_pos = text_box_y + box_bezel_height;
   }
+}
+
+/* Appends a character to the console's line ring */
+static void console_put(char c)
+{
+  uint8_t slot = console_last & (EZLCD_CONSOLE_LINES - 1);
+  
+  if(c == '\n' || console_length[slot] >= console_columns)
+  {
+    ++console_last;
+    if(console_count < EZLCD_CONSOLE_LINES)
+      ++console_count;
+    slot = console_last & (EZLCD_CONSOLE_LINES - 1);
+    console_length[slot] = 0;
+  }
+  if(c != '\n')
+    console_text[slot][console_length[slot]++] = c;
+  
+  console_dirty = 1;
+}
+
+/* Returns 1 if @a row still shows exactly @a length characters of @a text.
+ * Lines only grow while held, so the row's line in the ring is what it
+ * shows; once the ring has reused its slot the row is assumed stale. */
+static uint8_t console_row_shows(uint8_t row, const char *text,
+                                 uint8_t length)
+{
+  const char *shown;
+  
+  if(row_length[row] != length ||
+     (uint16_t)(console_last - row_line[row]) >= console_count)
+    return 0;
+  
+  shown = console_text[row_line[row] & (EZLCD_CONSOLE_LINES - 1)];
+  while(length--)
+    if(*shown++ != *text++)
+      return 0;
+  return 1;
+}
+
+void ezLCD_console_refresh(void)
+{
+  uint8_t  from[EZLCD_CONSOLE_ROWS];     /* First column to print, per row */
+  uint8_t  used;                         /* Rows holding a line, from the top */
+  uint8_t  clear = 0;
+  uint8_t  print = 0;
+  uint8_t  row;
+  uint8_t  length;
+  uint8_t  up;
+  uint16_t line;
+  uint16_t x = text_box_x + box_bezel_width;
+  uint16_t y;
+  const char *text;
+  
+  console_dirty = 0;
+  console_stamp = ezLCD_event_clock();
+  
+  /* Lines fill the box from the top, so a new line only moves the others
+   * once the box is full. The rows below the used ones come out with an
+   * out of range up, and so empty. */
+  used = (console_count < console_rows) ? console_count : console_rows;
+  
+  /* Decide what each row needs: nothing, the characters added to its line,
+   * or to be cleared and printed again */
+  for(row = 0; row < console_rows; ++row)
+  {
+    up     = console_back + used - 1 - row;
+    line   = console_last - up;
+    length = (up < console_count)
+           ? console_length[line & (EZLCD_CONSOLE_LINES - 1)] : 0;
+    text   = console_text[line & (EZLCD_CONSOLE_LINES - 1)];
+    
+    if(row_length[row] == 0 ||
+       (row_line[row] == line && row_length[row] <= length))
+      from[row] = row_length[row];
+    else if(console_row_shows(row, text, length))
+      from[row] = length;
+    else
+    {
+      from[row]  = 0;
+      row_length[row] = 0xFF;             /* Marks the row to be cleared */
+      clear = 1;
+    }
+    if(from[row] < length)
+      print = 1;
+    row_line[row] = line;
+  }
+  
+  /* Clear the rows first so the colour is set once for all of them, with
+   * one rectangle per run of adjacent rows */
+  if(clear)
+  {
+    ezLCD_set_color_rgb(tb_r, tb_g, tb_b);
+    for(row = 0; row < console_rows; ++row)
+    {
+      if(row_length[row] != 0xFF)
+        continue;
+      y = text_box_y + box_bezel_height + row * (font_h + 2);
+      while(row < console_rows && row_length[row] == 0xFF)
+        row_length[row++] = 0;
+      ezLCD_set_xy(x, y);
+      ezLCD_draw_rect_fill(text_box_x + text_box_width - box_bezel_width,
+                           text_box_y + box_bezel_height
+                           + row * (font_h + 2) - 1);
+    }
+  }
+  
+  if(print)
+    ezLCD_set_color_rgb(text_r, text_g, text_b);
+  for(row = 0; row < console_rows; ++row)
+  {
+    up     = console_back + used - 1 - row;
+    length = (up < console_count)
+           ? console_length[row_line[row] & (EZLCD_CONSOLE_LINES - 1)] : 0;
+    text   = console_text[row_line[row] & (EZLCD_CONSOLE_LINES - 1)];
+    
+    if(from[row] < length)
+    {
+      /* One PRINT_STRING for whatever the row is missing */
+      ezLCD_set_xy(x + from[row] * (font_w + 1),
+                   text_box_y + box_bezel_height + row * (font_h + 2));
+      ezLCD_cmd_put(0x2D);
+      for(up = from[row]; up < length; ++up)
+        ezLCD_cmd_put(text[up]);
+      ezLCD_cmd_put(0x00);                    /* String terminator */
+      ezLCD_cmd_flush();
+    }
+    row_length[row] = length;
+  }
+}
+
+/* Refreshes the console unless the last refresh was too recent */
+static void console_update(void)
+{
+  if(console_ticks &&
+     (uint16_t)(ezLCD_event_clock() - console_stamp) < console_ticks)
+    return;
+  ezLCD_console_refresh();
+}
+
+void ezLCD_console_begin(uint16_t refresh_ticks)
+{
+  uint8_t row;
+  
+  ezLCD_putchar_flush();
+  
+  /* A box too small for one row or column shows nothing */
+  console_rows = 0;
+  if(text_box_height >= 2 * box_bezel_height + font_h)
+    console_rows = (text_box_height - 2 * box_bezel_height + 2) / (font_h + 2);
+  if(console_rows > EZLCD_CONSOLE_ROWS)
+    console_rows = EZLCD_CONSOLE_ROWS;
+  console_columns = 0;
+  if(text_box_width >= 2 * box_bezel_width + font_w)
+    console_columns = (text_box_width - 2 * box_bezel_width + 1) / (font_w + 1);
+  if(console_columns > EZLCD_CONSOLE_COLUMNS)
+    console_columns = EZLCD_CONSOLE_COLUMNS;
+  
+  console_last      = 0;
+  console_count     = 1;
+  console_back      = 0;
+  console_length[0] = 0;
+  console_ticks     = refresh_ticks;
+  console_stamp     = ezLCD_event_clock() - refresh_ticks;
+  console_dirty     = 0;
+  for(row = 0; row < EZLCD_CONSOLE_ROWS; ++row)
+  {
+    row_line[row]   = 0;
+    row_length[row] = 0;
+  }
+  
+  /* Start from an empty text box */
+  ezLCD_set_color_rgb(tb_r, tb_g, tb_b);
+  ezLCD_set_xy(text_box_x, text_box_y);
+  ezLCD_draw_rect_fill(text_box_x + text_box_width, text_box_y + text_box_height);
+  ezLCD_set_color_rgb(text_r, text_g, text_b);
+  
+  console_on = 1;
+}
+
+uint8_t ezLCD_console_poll(void)
+{
+  if(!console_on || !console_dirty)
+    return 0;
+  if(console_ticks &&
+     (uint16_t)(ezLCD_event_clock() - console_stamp) < console_ticks)
+    return 0;
+  ezLCD_console_refresh();
+  return 1;
+}
+
+void ezLCD_console_scroll(uint8_t back)
+{
+  if(console_count <= console_rows)
+    back = 0;
+  else if(back > console_count - console_rows)
+    back = console_count - console_rows;
+  if(back == console_back)
+    return;
+  
+  console_back  = back;
+  console_dirty = 1;
+  console_update();
+}
+
+/* Prints a string into the text box with one PRINT_STRING (0x2D) or
+ * PRINT_STRING_BG (0x3D) transaction per line. */
+static void text_box_puts(const char *s, uint8_t command)
+{
+  uint16_t x_limit = text_box_x + text_box_width + box_bezel_width - font_w;
+  
+  if(console_on)
+  {
+    while(*s)
+      console_put(*s++);
+    console_update();
+    return;
+  }
+  
+  ezLCD_set_color_rgb(text_r, text_g, text_b);
+  
+  while(*s)
+  {
+    if(x_pos >= x_limit || *s == '\n')
+    {
+      text_box_line_feed();
+      if(*s == '\n')
+      {
+        ++s;
+        continue;
+      }
+    }
+    text_box_wrap();
+    
+    /* One cursor placement for the whole line */
+    ezLCD_set_xy(x_pos, y_pos);
+    
+    /* At least one character per line, as putchar() does, so a box
+     * narrower than a glyph, or one never set up, cannot stall the loop */
+    ezLCD_cmd_put(command);
+    do
+    {
+      ezLCD_cmd_put(*s++);
+      x_pos += (font_w + 1);
+    } while(*s && *s != '\n' && x_pos < x_limit);
+    ezLCD_cmd_put(0x00);                      /* String terminator */
+    ezLCD_cmd_flush();
+  }
+}
+
+void ezLCD_puts(const char *s)
+{
+  ezLCD_putchar_flush();
+  text_box_puts(s, 0x2D);
+}
+
+void ezLCD_puts_bg(const char *s)
+{
+  ezLCD_putchar_flush();
+  text_box_puts(s, 0x3D);
+}
+
+void ezLCD_putchar_buffer(uint8_t enable)
+{
+  ezLCD_putchar_flush();
+  stdio_buffered = enable;
+}
+
+void ezLCD_putchar_flush(void)
+{
+  if(!stdio_length)
+    return;
+  
+  stdio_buffer[stdio_length] = 0;
+  stdio_length = 0;
+  text_box_puts(stdio_buffer, 0x2D);
+}
+
+/* Powers of ten for print_number(), largest first */
+static const EZLCD_FLASH uint32_t print_powers[10] =
+{
+  1000000000UL, 100000000UL, 10000000UL, 1000000UL, 100000UL,
+  10000UL, 1000UL, 100UL, 10UL, 1UL
+};
+
+/* Pads a formatted number to @a width and prints it, into the putchar()
+ * buffer when buffering so that it joins the surrounding text */
+static void print_field(const char *digits, uint8_t count, char sign,
+                        uint8_t width, char pad)
+{
+  char    text[EZLCD_PRINT_WIDTH + 1];
+  uint8_t length = count + (sign ? 1 : 0);
+  uint8_t i = 0;
+  
+  if(sign && pad == '0')                      /* -0042 */
+    text[i++] = sign;
+  for(; length < width && length < EZLCD_PRINT_WIDTH; ++length)
+    text[i++] = pad;
+  if(sign && pad != '0')                      /*   -42 */
+    text[i++] = sign;
+  while(count--)
+    text[i++] = *digits++;
+  text[i] = 0;
+  
+  if(stdio_buffered)
+  {
+    for(i = 0; text[i]; ++i)
+      putchar(text[i]);
+  }
+  else
+    ezLCD_puts(text);
+}
+
+/* Formats a magnitude in decimal with @a decimals digits after the point,
+ * by subtracting powers of ten rather than dividing */
+static void print_number(uint32_t value, char sign, uint8_t decimals,
+                         uint8_t width, char pad)
+{
+  char    digits[11];
+  char    digit;
+  uint8_t count = 0;
+  uint8_t i;
+  uint32_t power;
+  
+  if(decimals > 9)
+    decimals = 9;
+  
+  for(i = 0; i < 10; ++i)
+  {
+    power = print_powers[i];
+    digit = '0';
+    while(value >= power)
+    {
+      value -= power;
+      ++digit;
+    }
+    
+    /* Skip leading zeros, but keep one before the point */
+    if(!count && digit == '0' && i < 9 - decimals)
+      continue;
+    if(decimals && i == 10 - decimals)
+      digits[count++] = '.';
+    digits[count++] = digit;
+  }
+  
+  print_field(digits, count, sign, width, pad);
+}
+
+void ezLCD_print_uint(uint32_t value, uint8_t width, char pad)
+{
+  print_number(value, 0, 0, width, pad);
+}
+
+void ezLCD_print_int(int32_t value, uint8_t width, char pad)
+{
+  ezLCD_print_fixed(value, 0, width, pad);
+}
+
+void ezLCD_print_fixed(int32_t value, uint8_t decimals, uint8_t width,
+                       char pad)
+{
+  if(value < 0)
+    print_number(0 - (uint32_t)value, '-', decimals, width, pad);
+  else
+    print_number(value, 0, decimals, width, pad);
+}
+
+void ezLCD_print_hex(uint32_t value, uint8_t width, char pad)
+{
+  char    digits[8];
+  uint8_t count = 8;
+  uint8_t nibble;
+  
+  /* Least significant digit first, from the end of the array */
+  do
+  {
+    nibble = value & 0x0F;
+    digits[--count] = (nibble < 10) ? '0' + nibble : 'A' - 10 + nibble;
+    value >>= 4;
+  } while(value);
+  
+  print_field(digits + count, 8 - count, 0, width, pad);
+}
+
+int putchar(int c)
+{
+  /* Character 0 would end the buffered string, so it is sent on its own */
+  if(stdio_buffered)
+  {
+    if(c != 0)
+    {
+      stdio_buffer[stdio_length++] = c;
+      if(c == '\n' || stdio_length == EZLCD_PUTCHAR_BUFFER_SIZE)
+        ezLCD_putchar_flush();
+      return c;
+    }
+    ezLCD_putchar_flush();
+  }
+  
+  if(console_on)
+  {
+    console_put(c);
+    console_update();
+    return c;
+  }
+  
+  ezLCD_set_color_rgb(text_r, text_g, text_b);
+  
+  if(x_pos >= (text_box_x + text_box_width + box_bezel_width - font_w) || c == '\n')
+  {
+    text_box_line_feed();
+  }
+  
+  text_box_wrap();
+  
   /* Set the character's coordinates */
   ezLCD_set_xy(x_pos, y_pos);
   
@@ -228,6 +228,225 @@ void ezLCD_putchar_bg(char c);
  */ 
 int putchar(int c);
 
+/** Prints a null-terminated string into the text box created with
+ *  ezLCD_init_putchar(). Line feeds, wrapping and clearing of a full text box
+ *  behave exactly as they do for putchar(), but each line of text is sent as
+ *  a single PRINT_STRING command: the cursor is placed once per line and the
+ *  text color once per call, instead of once per character.
+ *
+ *  Works with both bitmap fonts and TTFs since it only uses the <b>current
+ *  font</b>. The display advances the cursor by each glyph's own width, so the
+ *  @a font_width given to ezLCD_init_putchar() is only used to decide where a
+ *  line wraps.
+ *
+ *  @par Parameters
+ *       - @a s = The desired string
+ *
+ *  @par Assumptions
+ *       - Character code 0 terminates the string. Use putchar() to print
+ *         the character at the TTF Unicode base itself.
+ *       - The user has properly sized the text box for the text they plan to 
+ *         print.
+ *       - The user has initialized the MCU's SPI interface with the
+ *         EZLCD_INIT_SPI() macro.
+ *       - The user has set the MCU's SPI pins to inputs and outputs 
+ *         appropriately. <BR><BR>
+ *         - SS_BAR = OUTPUT
+ *         - SCK    = OUTPUT
+ *         - MOSI   = OUTPUT
+ *         - MISO   = INPUT
+ *
+ */ 
+void ezLCD_puts(const char *s);
+
+/** Same as ezLCD_puts(), but every glyph is backed with the background color
+ *  set by ezLCD_set_background_color() (PRINT_STRING_BG).
+ *
+ *  @par Parameters
+ *       - @a s = The desired string
+ *
+ *  @par Assumptions
+ *       - See ezLCD_puts().
+ *
+ */ 
+void ezLCD_puts_bg(const char *s);
+
+/** Turns buffering of putchar() on or off. While it is on, characters from
+ *  putchar() and printf() are kept on the MCU until a newline, until
+ *  EZLCD_PUTCHAR_BUFFER_SIZE of them are waiting, or until
+ *  ezLCD_putchar_flush(), and then printed as with ezLCD_puts(): one cursor
+ *  placement per line and one text color per flush, about one byte per
+ *  glyph.
+ *
+ *  Pending text is flushed before the font or the TTF Unicode base changes,
+ *  before ezLCD_puts() and before the text box is set up again. Character 0
+ *  is printed on its own, as without buffering.
+ *
+ *  @par Parameters
+ *       - @a enable = 1 to buffer, 0 to print every character at once.
+ *         Turning buffering off flushes it.
+ *
+ *  @par Assumptions
+ *       - Text which must be on the screen before something else is drawn,
+ *         or before the frame changes, is flushed with ezLCD_putchar_flush().
+ *         IAR's fflush() does not reach the driver.
+ *       - See putchar().
+ */ 
+void ezLCD_putchar_buffer(uint8_t enable);
+
+/** Prints the characters buffered by putchar(), if any. See
+ *  ezLCD_putchar_buffer().
+ *
+ *  @par Assumptions
+ *       - See putchar().
+ */ 
+void ezLCD_putchar_flush(void);
+
+/** Prints a signed integer into the text box created with
+ *  ezLCD_init_putchar(), without printf(). The number is formatted on the
+ *  stack by subtracting powers of ten, which takes microseconds where
+ *  printf("%ld") takes milliseconds, and is printed as with ezLCD_puts(), or
+ *  joins the putchar() buffer while ezLCD_putchar_buffer() is on.
+ *
+ * @code
+    ezLCD_print_int(-42, 5, ' ');      // "  -42"
+    ezLCD_print_int(-42, 5, '0');      // "-0042"
+   @endcode
+ *
+ *  @par Parameters
+ *       - @a value = The number.
+ *       - @a width = Least number of characters printed, padded on the left.
+ *         Limited to EZLCD_PRINT_WIDTH, 0 for no padding.
+ *       - @a pad   = Padding character, e.g. ' ' or '0'. The sign goes
+ *         before '0' padding and after any other.
+ *
+ *  @par Assumptions
+ *       - See ezLCD_puts().
+ */ 
+void ezLCD_print_int(int32_t value, uint8_t width, char pad);
+
+/** Same as ezLCD_print_int() for an unsigned integer.
+ *
+ *  @par Parameters
+ *       - See ezLCD_print_int().
+ *
+ *  @par Assumptions
+ *       - See ezLCD_puts().
+ */ 
+void ezLCD_print_uint(uint32_t value, uint8_t width, char pad);
+
+/** Prints a decimal fixed-point number: @a value in units of
+ *  10^-@a decimals, so a temperature kept in hundredths of a degree is
+ *  printed with 2 decimal places. At least one digit comes before the
+ *  point.
+ *
+ * @code
+    ezLCD_print_fixed(2345, 2, 6, ' ');  // " 23.45"
+    ezLCD_print_fixed(-5, 2, 0, ' ');    // "-0.05"
+   @endcode
+ *
+ *  @par Parameters
+ *       - @a value    = The number, scaled by 10^@a decimals.
+ *       - @a decimals = Digits after the decimal point, in the set [0,9].
+ *       - @a width    = See ezLCD_print_int(). Includes the sign and point.
+ *       - @a pad      = See ezLCD_print_int().
+ *
+ *  @par Assumptions
+ *       - See ezLCD_puts().
+ */ 
+void ezLCD_print_fixed(int32_t value, uint8_t decimals, uint8_t width,
+                       char pad);
+
+/** Prints an unsigned integer in upper case hexadecimal, without a prefix.
+ *
+ * @code
+    ezLCD_print_hex(0x3C, 4, '0');     // "003C"
+   @endcode
+ *
+ *  @par Parameters
+ *       - See ezLCD_print_int().
+ *
+ *  @par Assumptions
+ *       - See ezLCD_puts().
+ */ 
+void ezLCD_print_hex(uint32_t value, uint8_t width, char pad);
+
+/** Turns the text box created with ezLCD_init_putchar() into a console.
+ *  putchar(), printf() and ezLCD_puts() then append to a ring of the last
+ *  EZLCD_CONSOLE_LINES lines kept on the MCU, and the text box shows the
+ *  newest of them. Lines fill the box from the top; when it is full it
+ *  scrolls up a line at a time instead of being cleared. A refresh only
+ *  sends the rows whose text changed, so until the box is full a character
+ *  or a new line costs one short PRINT_STRING.
+ *
+ *  Once the box scrolls, every row changes with every new line. The worst
+ *  case per line is then one clear of the box plus a cursor placement and a
+ *  PRINT_STRING per row: about 18 + rows x (7 + columns) bytes, 234 bytes for
+ *  8 rows of 20 characters, where the plain text box sends one line. With
+ *  @a refresh_ticks set, the box is redrawn at most once per that many
+ *  ticks of ezLCD_event_clock(), however fast lines arrive; lines scrolled
+ *  past in between are never sent, which bounds the cost to one such redraw
+ *  per interval. Call ezLCD_console_poll() regularly so the last lines
+ *  printed are shown. Calling ezLCD_init_putchar() returns to the plain text
+ *  box.
+ *
+ *  Works with bitmap fonts and TTFs of constant width. Lines wrap at the
+ *  box width or EZLCD_CONSOLE_COLUMNS characters, whichever is smaller, and
+ *  at most EZLCD_CONSOLE_ROWS rows are used. Rows are cleared to the text
+ *  box color before they are printed, so ezLCD_puts_bg() prints just like
+ *  ezLCD_puts() here.
+ *
+ *  @par Parameters
+ *       - @a refresh_ticks = Least ticks between two refreshes, 0 to refresh
+ *         on every write.
+ *
+ *  @par Assumptions
+ *       - ezLCD_init_putchar() has been called.
+ *       - When @a refresh_ticks is not 0, ezLCD_event_tick() is running, 
+ *         e.g. with EZLCD_TOUCH_TIMER.
+ *       - The user has initialized the MCU's SPI interface with the
+ *         EZLCD_INIT_SPI() macro.
+ *       - The user has set the MCU's SPI pins to inputs and outputs 
+ *         appropriately. <BR><BR>
+ *         - SS_BAR = OUTPUT
+ *         - SCK    = OUTPUT
+ *         - MOSI   = OUTPUT
+ *         - MISO   = INPUT
+ *
+ */ 
+void ezLCD_console_begin(uint16_t refresh_ticks);
+
+/** Redraws the console rows which changed since the last refresh, whether
+ *  or not one is due.
+ *
+ *  @par Assumptions
+ *       - See ezLCD_console_begin().
+ */ 
+void ezLCD_console_refresh(void);
+
+/** Redraws the console if text was added since the last refresh and the
+ *  refresh interval given to ezLCD_console_begin() has passed. Meant for
+ *  the main loop.
+ *
+ *  @returns 1 if the console was redrawn, 0 otherwise.
+ *
+ *  @par Assumptions
+ *       - See ezLCD_console_begin().
+ */ 
+uint8_t ezLCD_console_poll(void);
+
+/** Scrolls the console back through the line ring. New text is still kept
+ *  while scrolled back; the view stays @a back lines behind the newest one.
+ *
+ *  @par Parameters
+ *       - @a back = Lines to scroll back from the newest, 0 to follow the
+ *         output. Limited to the lines held.
+ *
+ *  @par Assumptions
+ *       - See ezLCD_console_begin().
+ */ 
+void ezLCD_console_scroll(uint8_t back);
+
 /** Used to set the TTF Unicode base. TTFs consist of many different characters 
  *  that need to be addressed; however, it is desirable to only send one byte to 
  *  the display whenever possible. It is also desirable to use the same text 
@@ -0,0 +1,512 @@
+/*
+ * @file   ezLCD_103_touch.c  <br>
+ * @author agent <br>
+ * @date   October 2026  <br>
+ * @brief  ezLCD calibratedXY touch decoding, hit-testing and gestures
+ *         source file  <br>
+ * @defgroup ezLCD_103_touch calibratedXY Touch
+ * @{
+ *
+ * This source contains functions used to decode calibratedXY touch packets
+ * to look touch positions up in a hit index and to recognize gestures.
+ */
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include "ezLCD_103_common.h"
+#include "ezLCD_103_touch.h"
+
+/*----------------------------------------------------------------------------*/
+/* CONSTANTS                                                                  */
+/*----------------------------------------------------------------------------*/
+#define TOUCH_X          0x81   /* Packet header: X coordinate follows */
+#define TOUCH_Y          0x82   /* Packet header: Y coordinate follows */
+#define PEN_UP           0x83   /* Packet header: screen released */
+#define PACKET_HEADER    0x80   /* Set in headers, clear in data bytes */
+#define REPORT_BYTES     6      /* An X packet and a Y packet */
+
+#define HIT_CELLS        (EZLCD_HIT_COLUMNS * EZLCD_HIT_ROWS)
+#define HIT_REGIONS      255    /* Regions an index can number in a byte */
+
+#if EZLCD_HIT_ENTRIES > 255
+#error "EZLCD_HIT_ENTRIES must fit the byte offsets of ezLCD_hit_index_t"
+#endif
+
+#if EZLCD_TOUCH_MEDIAN < 1 || EZLCD_TOUCH_MEDIAN > 9 || \
+    !(EZLCD_TOUCH_MEDIAN & 1)
+#error "EZLCD_TOUCH_MEDIAN must be 1, 3, 5, 7 or 9"
+#endif
+/* Raw samples kept for the median, one unused when it is off */
+#define FILTER_HISTORY   (EZLCD_TOUCH_MEDIAN > 1 ? EZLCD_TOUCH_MEDIAN - 1 : 1)
+
+#define GESTURE_IDLE     0      /* Pen up */
+#define GESTURE_PRESSED  1      /* Pen down, still within the slop */
+#define GESTURE_HELD     2      /* Long press reported, waiting for pen up */
+#define GESTURE_DRAGGING 3      /* Moved beyond the slop */
+
+/*----------------------------------------------------------------------------*/
+/* VARIABLES                                                                  */
+/*----------------------------------------------------------------------------*/
+static uint8_t  touch_packet;   /* Header of the packet being received, or 0 */
+static uint8_t  touch_count;    /* Data bytes of it received so far */
+static uint8_t  touch_low;      /* Its first data byte */
+static uint8_t  touch_have_x;   /* An X arrived and waits for its Y */
+static uint8_t  touch_down;     /* The pen is on the screen */
+static uint16_t touch_x;        /* Last X received */
+static uint16_t touch_y;        /* Last Y received */
+
+static uint16_t filter_x[FILTER_HISTORY];  /* Raw positions, newest first */
+static uint16_t filter_y[FILTER_HISTORY];
+static uint16_t smooth_x;       /* Low pass output in 1/16 pixels */
+static uint16_t smooth_y;
+static uint16_t output_x;       /* Position last reported */
+static uint16_t output_y;
+
+static uint8_t  gesture_state;  /* GESTURE_* below */
+static uint16_t gesture_start;  /* Time of the pen down */
+static uint16_t gesture_sent;   /* Time of the last drag report */
+static uint16_t start_x;        /* Position of the pen down */
+static uint16_t start_y;
+static uint16_t sent_x;         /* Position of the last drag report */
+static uint16_t sent_y;
+static uint16_t last_x;         /* Latest position */
+static uint16_t last_y;
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+/* Distance between two coordinates */
+static uint16_t touch_distance(uint16_t a, uint16_t b)
+{
+  return a > b ? a - b : b - a;
+}
+
+void ezLCD_touch_reset(void)
+{
+  touch_packet = 0;
+  touch_have_x = 0;
+  touch_down   = 0;
+}
+
+ezLCD_touch_kind_t ezLCD_touch_feed(uint8_t data, ezLCD_touch_t *touch)
+{
+  ezLCD_touch_kind_t kind;
+  uint16_t           value;
+
+  if(data & PACKET_HEADER)
+  {
+    touch_packet = 0;
+    touch_count  = 0;
+
+    if(data == TOUCH_X || data == TOUCH_Y)
+    {
+      touch_packet = data;
+      return EZLCD_TOUCH_NONE;
+    }
+
+    if(data != PEN_UP || !touch_down)
+      return EZLCD_TOUCH_NONE;
+
+    touch_down   = 0;
+    touch_have_x = 0;
+    kind         = EZLCD_TOUCH_UP;
+  }
+  else
+  {
+    if(!touch_packet)
+      return EZLCD_TOUCH_NONE;                /* Idle byte */
+
+    if(touch_count++ == 0)
+    {
+      touch_low = data;                       /* Bits 0-6 */
+      return EZLCD_TOUCH_NONE;
+    }
+
+    value = touch_low | ((uint16_t)data << 7);/* Bits 7-14 */
+
+    if(touch_packet == TOUCH_X)
+    {
+      touch_packet = 0;
+      touch_x      = value;
+      touch_have_x = 1;
+      return EZLCD_TOUCH_NONE;
+    }
+
+    touch_packet = 0;
+    touch_y      = value;
+    if(!touch_have_x)
+      return EZLCD_TOUCH_NONE;                /* Y without X, e.g. after reset */
+
+    touch_have_x = 0;
+    kind         = touch_down ? EZLCD_TOUCH_MOVE : EZLCD_TOUCH_DOWN;
+    touch_down   = 1;
+  }
+
+  touch->kind = kind;
+  touch->x    = touch_x;
+  touch->y    = touch_y;
+  return kind;
+}
+
+#if EZLCD_TOUCH_MEDIAN > 1
+/* Median of @a raw and the history, which then takes @a raw as its newest
+ * sample. An insertion sort, short enough for the few samples kept. */
+static uint16_t filter_median(uint16_t raw, uint16_t *history)
+{
+  uint16_t sorted[EZLCD_TOUCH_MEDIAN];
+  uint16_t value;
+  uint8_t  i;
+  uint8_t  j;
+
+  sorted[0] = raw;
+  for(i = 1; i < EZLCD_TOUCH_MEDIAN; ++i)
+  {
+    value = history[i - 1];
+    for(j = i; j > 0 && sorted[j - 1] > value; --j)
+      sorted[j] = sorted[j - 1];
+    sorted[j] = value;
+  }
+
+  for(i = FILTER_HISTORY - 1; i > 0; --i)
+    history[i] = history[i - 1];
+  history[0] = raw;
+
+  return sorted[EZLCD_TOUCH_MEDIAN / 2];
+}
+#endif /* EZLCD_TOUCH_MEDIAN */
+
+/* Runs one axis of a move through the median and the low pass */
+static uint16_t filter_axis(uint16_t raw, uint16_t *history, uint16_t *smooth)
+{
+  uint16_t value = raw;
+
+#if EZLCD_TOUCH_MEDIAN > 1
+  value = filter_median(raw, history);
+#else
+  (void)history;
+#endif /* EZLCD_TOUCH_MEDIAN */
+
+  /* Kept unsigned and shifted on the magnitude, so both directions round
+   * the same way without relying on signed shifts */
+  value <<= 4;
+  if(value >= *smooth)
+    *smooth += (uint16_t)(value - *smooth) >> EZLCD_TOUCH_SMOOTH_SHIFT;
+  else
+    *smooth -= (uint16_t)(*smooth - value) >> EZLCD_TOUCH_SMOOTH_SHIFT;
+
+  return (*smooth + 8) >> 4;
+}
+
+ezLCD_touch_kind_t ezLCD_touch_filter(ezLCD_touch_t *touch)
+{
+  uint16_t x;
+  uint16_t y;
+  uint8_t  i;
+
+  switch(touch->kind)
+  {
+    case EZLCD_TOUCH_DOWN:
+      for(i = 0; i < FILTER_HISTORY; ++i)
+      {
+        filter_x[i] = touch->x;
+        filter_y[i] = touch->y;
+      }
+      output_x    = touch->x;
+      output_y    = touch->y;
+      smooth_x    = touch->x << 4;
+      smooth_y    = touch->y << 4;
+      break;
+
+    case EZLCD_TOUCH_MOVE:
+      x = filter_axis(touch->x, filter_x, &smooth_x);
+      y = filter_axis(touch->y, filter_y, &smooth_y);
+      if(touch_distance(x, output_x) <= EZLCD_TOUCH_DEADBAND &&
+         touch_distance(y, output_y) <= EZLCD_TOUCH_DEADBAND)
+        return EZLCD_TOUCH_NONE;
+      touch->x = output_x = x;
+      touch->y = output_y = y;
+      break;
+
+    case EZLCD_TOUCH_UP:
+      touch->x = output_x;
+      touch->y = output_y;
+      break;
+
+    default:
+      break;
+  }
+
+  return touch->kind;
+}
+
+ezLCD_touch_kind_t ezLCD_touch_poll(ezLCD_touch_t *touch)
+{
+  ezLCD_touch_kind_t kind;
+  uint8_t            data;
+  uint8_t            i;
+
+  /* Bytes harvested during drawing commands first, then no-op polls, which
+   * queue their replies behind them. Bounded so that a stream of headers
+   * cannot hang the caller; a report left unfinished is completed by the
+   * next call. */
+  ezLCD_spi_wait();
+  for(i = 0; ; ++i)
+  {
+    while(ezLCD_event_touch_get(&data))
+    {
+      if(ezLCD_touch_feed(data, touch) != EZLCD_TOUCH_NONE)
+      {
+        kind = ezLCD_touch_filter(touch);
+        if(kind != EZLCD_TOUCH_NONE)
+          return kind;
+      }
+    }
+
+    /* Stop as soon as the display has nothing more to say */
+    if(i == REPORT_BYTES ||
+       (i && !touch_packet && !touch_have_x && !(data & PACKET_HEADER)))
+      break;
+
+    data = ezLCD_event_poll();                /* NOP */
+  }
+
+  return EZLCD_TOUCH_NONE;
+}
+
+/* Finds the range of cells a region overlaps, clipped to the screen.
+ * Returns 0 if it overlaps none: empty, or entirely off the screen. */
+static uint8_t hit_cells(const EZLCD_FLASH ezLCD_hit_region_t *region,
+                         uint8_t *column_first, uint8_t *column_last,
+                         uint8_t *row_first,    uint8_t *row_last)
+{
+  uint16_t x      = region->x;
+  uint16_t y      = region->y;
+  uint16_t width  = region->width;
+  uint16_t height = region->height;
+
+  if(!width || !height || x >= EZLCD_WIDTH || y >= EZLCD_HEIGHT)
+    return 0;
+  if(width > EZLCD_WIDTH - x)
+    width = EZLCD_WIDTH - x;
+  if(height > EZLCD_HEIGHT - y)
+    height = EZLCD_HEIGHT - y;
+
+  /* Within the screen, so within the grid */
+  *column_first = x / EZLCD_HIT_CELL_WIDTH;
+  *row_first    = y / EZLCD_HIT_CELL_HEIGHT;
+  *column_last  = (x + width  - 1) / EZLCD_HIT_CELL_WIDTH;
+  *row_last     = (y + height - 1) / EZLCD_HIT_CELL_HEIGHT;
+  return 1;
+}
+
+uint8_t ezLCD_hit_index_build(ezLCD_hit_index_t *index,
+                              const EZLCD_FLASH ezLCD_hit_region_t *regions,
+                              uint16_t count)
+{
+  uint8_t  column_first, column_last, row_first, row_last;
+  uint8_t  column, row;
+  uint16_t total;
+  uint16_t n;
+
+  index->regions = regions;
+  for(n = 0; n <= HIT_CELLS; ++n)
+    index->cell[n] = 0;
+  if(count > HIT_REGIONS)
+    return 0;
+
+  /* Count the regions overlapping each cell */
+  total = 0;
+  for(n = 0; n < count; ++n)
+  {
+    if(!hit_cells(&regions[n],
+                  &column_first, &column_last, &row_first, &row_last))
+      continue;
+    for(row = row_first; row <= row_last; ++row)
+      for(column = column_first; column <= column_last; ++column)
+        ++index->cell[row * EZLCD_HIT_COLUMNS + column];
+    total += (uint16_t)(column_last - column_first + 1) *
+                       (row_last    - row_first    + 1);
+  }
+
+  if(total > EZLCD_HIT_ENTRIES)
+  {
+    for(n = 0; n < HIT_CELLS; ++n)
+      index->cell[n] = 0;
+    return 0;
+  }
+
+  /* Turn the counts into the end of each cell's entries... */
+  total = 0;
+  for(n = 0; n < HIT_CELLS; ++n)
+  {
+    total         += index->cell[n];
+    index->cell[n] = total;
+  }
+  index->cell[HIT_CELLS] = total;
+
+  /* ...and fill each cell from its end, last region first, which leaves
+   * cell[] at the start of each cell and the entries in table order */
+  for(n = count; n-- != 0;)
+  {
+    if(!hit_cells(&regions[n],
+                  &column_first, &column_last, &row_first, &row_last))
+      continue;
+    for(row = row_first; row <= row_last; ++row)
+      for(column = column_first; column <= column_last; ++column)
+        index->entry[--index->cell[row * EZLCD_HIT_COLUMNS + column]] = n;
+  }
+
+  return 1;
+}
+
+uint16_t ezLCD_hit_test(const ezLCD_hit_index_t *index, uint16_t x, uint16_t y)
+{
+  const EZLCD_FLASH ezLCD_hit_region_t *region;
+  uint16_t cell;
+  uint16_t first;
+  uint16_t n;
+
+  if(x >= EZLCD_WIDTH || y >= EZLCD_HEIGHT)
+    return EZLCD_HIT_NONE;
+
+  cell  = (y / EZLCD_HIT_CELL_HEIGHT) * EZLCD_HIT_COLUMNS
+        +  x / EZLCD_HIT_CELL_WIDTH;
+  first = index->cell[cell];
+
+  /* Last listed region first, since it is drawn on top */
+  for(n = index->cell[cell + 1]; n-- != first;)
+  {
+    region = &index->regions[index->entry[n]];
+    if(x >= region->x && x - region->x < region->width &&
+       y >= region->y && y - region->y < region->height)
+      return region->id;
+  }
+
+  return EZLCD_HIT_NONE;
+}
+
+void ezLCD_gesture_reset(void)
+{
+  gesture_state = GESTURE_IDLE;
+}
+
+/* Reports the movement since the last drag report */
+static ezLCD_gesture_kind_t gesture_drag(uint16_t now, ezLCD_gesture_t *gesture)
+{
+  gesture->kind = EZLCD_GESTURE_DRAG;
+  gesture->x    = last_x;
+  gesture->y    = last_y;
+  gesture->dx   = (int16_t)(last_x - sent_x);
+  gesture->dy   = (int16_t)(last_y - sent_y);
+  sent_x        = last_x;
+  sent_y        = last_y;
+  gesture_sent  = now;
+  return EZLCD_GESTURE_DRAG;
+}
+
+ezLCD_gesture_kind_t ezLCD_gesture_feed(const ezLCD_touch_t *touch,
+                                        uint16_t now,
+                                        ezLCD_gesture_t *gesture)
+{
+  uint16_t distance_x;
+  uint16_t distance_y;
+  uint8_t  state = gesture_state;
+
+  switch(touch->kind)
+  {
+    case EZLCD_TOUCH_DOWN:
+      gesture_state = GESTURE_PRESSED;
+      gesture_start = now;
+      start_x = sent_x = last_x = touch->x;
+      start_y = sent_y = last_y = touch->y;
+      return EZLCD_GESTURE_NONE;
+
+    case EZLCD_TOUCH_MOVE:
+      if(state == GESTURE_IDLE)
+        return EZLCD_GESTURE_NONE;          /* Began before a reset */
+      last_x = touch->x;
+      last_y = touch->y;
+
+      if(state == GESTURE_DRAGGING)
+        break;                              /* Coalesced below */
+
+      if(touch_distance(last_x, start_x) <= EZLCD_GESTURE_SLOP &&
+         touch_distance(last_y, start_y) <= EZLCD_GESTURE_SLOP)
+        break;
+
+      /* The first drag is reported at once so the widget follows the
+       * finger without waiting a whole interval */
+      gesture_state = GESTURE_DRAGGING;
+      return gesture_drag(now, gesture);
+
+    case EZLCD_TOUCH_UP:
+      gesture_state = GESTURE_IDLE;
+
+      if(state == GESTURE_PRESSED)
+      {
+        gesture->kind = EZLCD_GESTURE_TAP;
+        gesture->x    = start_x;
+        gesture->y    = start_y;
+        return EZLCD_GESTURE_TAP;
+      }
+
+      if(state != GESTURE_DRAGGING)
+        return EZLCD_GESTURE_NONE;
+
+      distance_x = touch_distance(last_x, start_x);
+      distance_y = touch_distance(last_y, start_y);
+      if((uint16_t)(now - gesture_start) <= EZLCD_GESTURE_SWIPE_TICKS &&
+         (distance_x >= EZLCD_GESTURE_SWIPE_PIXELS ||
+          distance_y >= EZLCD_GESTURE_SWIPE_PIXELS))
+      {
+        gesture->kind = EZLCD_GESTURE_SWIPE;
+        gesture->x    = last_x;
+        gesture->y    = last_y;
+        gesture->dx   = (int16_t)(last_x - start_x);
+        gesture->dy   = (int16_t)(last_y - start_y);
+        if(distance_x >= distance_y)
+          gesture->direction = last_x < start_x ? EZLCD_SWIPE_LEFT
+                                                : EZLCD_SWIPE_RIGHT;
+        else
+          gesture->direction = last_y < start_y ? EZLCD_SWIPE_UP
+                                                : EZLCD_SWIPE_DOWN;
+        return EZLCD_GESTURE_SWIPE;
+      }
+
+      /* Let the widget settle where the finger left it */
+      if(last_x != sent_x || last_y != sent_y)
+        return gesture_drag(now, gesture);
+      return EZLCD_GESTURE_NONE;
+
+    default:
+      break;
+  }
+
+  /* Reports which depend on time alone */
+  if(gesture_state == GESTURE_PRESSED &&
+     (uint16_t)(now - gesture_start) >= EZLCD_GESTURE_LONG_TICKS)
+  {
+    gesture_state = GESTURE_HELD;
+    gesture->kind = EZLCD_GESTURE_LONG_PRESS;
+    gesture->x    = start_x;
+    gesture->y    = start_y;
+    return EZLCD_GESTURE_LONG_PRESS;
+  }
+
+  if(gesture_state == GESTURE_DRAGGING &&
+     (last_x != sent_x || last_y != sent_y) &&
+     (uint16_t)(now - gesture_sent) >= EZLCD_GESTURE_DRAG_TICKS)
+    return gesture_drag(now, gesture);
+
+  return EZLCD_GESTURE_NONE;
+}
+
+ezLCD_gesture_kind_t ezLCD_gesture_poll(ezLCD_gesture_t *gesture)
+{
+  ezLCD_touch_t touch;
+
+  touch.kind = ezLCD_touch_poll(&touch);
+  return ezLCD_gesture_feed(&touch, ezLCD_event_clock(), gesture);
+}
+/** @} */ /* ezLCD_103_touch */
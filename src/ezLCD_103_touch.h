@@ -0,0 +1,300 @@
+/**
+ * @file   ezLCD_103_touch.h  <br>
+ * @author agent <br>
+ * @date   October 2026  <br>
+ * @brief  ezLCD calibratedXY touch decoding, hit-testing and gestures
+ *         header file  <br>
+ * @defgroup ezLCD_103_touch calibratedXY Touch
+ * @{
+ *
+ * This header contains functions used to work with the calibratedXY touch
+ * protocol. In this protocol the display does not know about buttons at all:
+ * while the screen is touched it streams the calibrated pen position, 5 to 50
+ * times per second, as packets of three bytes each:
+ *
+ * - TOUCH_X (0x81), bits 0-6 of X, bits 7-14 of X
+ * - TOUCH_Y (0x82), bits 0-6 of Y, bits 7-14 of Y
+ * - PEN_UP  (0x83) alone, once the screen is released
+ *
+ * ezLCD_touch_poll() reads and decodes these packets. Since no buttons are
+ * defined on the display, deciding what was touched is left to the MCU. For
+ * that, this module keeps a hit index: the screen is cut into a grid of
+ * EZLCD_HIT_COLUMNS by EZLCD_HIT_ROWS cells and every cell lists the regions
+ * which overlap it. Looking a point up then only tests the few regions of
+ * one cell, however many regions there are, and nothing but the picture of
+ * a page has to be sent to the display. This lifts the 64 button limit of
+ * the ezButton protocol, and a page of a hundred keys costs no more bus time
+ * than a page of one.
+ *
+ * @code
+    static const EZLCD_FLASH ezLCD_hit_region_t keys[] =
+    {
+      {   0, 0, 32, 32, KEY_A },
+      {  32, 0, 32, 32, KEY_B },
+      ...
+    };
+    static ezLCD_hit_index_t keyboard;
+    ezLCD_touch_t            touch;
+
+    ezLCD_set_touch_protocol(calibratedXY);
+    ezLCD_hit_index_build(&keyboard, keys, sizeof(keys)/sizeof(keys[0]));
+
+    if(ezLCD_touch_poll(&touch) == EZLCD_TOUCH_DOWN)
+      key = ezLCD_hit_test(&keyboard, touch.x, touch.y);
+   @endcode
+ *
+ * A finger resting on the screen is reported with a few pixels of jitter,
+ * and each reported move would redraw whatever is under it. So
+ * ezLCD_touch_poll() passes every move through ezLCD_touch_filter() first:
+ * a median of EZLCD_TOUCH_MEDIAN samples drops spikes, a first order low
+ * pass (EZLCD_TOUCH_SMOOTH_SHIFT) smooths what is left, and moves no larger
+ * than EZLCD_TOUCH_DEADBAND are not reported at all. The filter works in
+ * 1/16 pixel fixed point and, as configured by default, delays a movement
+ * by at most one sample.
+ *
+ * Sliders and scrolling lists need more than the touched point. The gesture
+ * engine (ezLCD_gesture_poll()) turns the same stream into taps, long
+ * presses, drags and swipes. Drag samples are coalesced: however fast the
+ * display reports, a drag is reported at most once every
+ * EZLCD_GESTURE_DRAG_TICKS with the whole movement since the last report, so
+ * the redraws it triggers stay within a fixed share of the bus:
+ *
+ * @code
+    ezLCD_gesture_t gesture;
+
+    switch(ezLCD_gesture_poll(&gesture))
+    {
+      case EZLCD_GESTURE_DRAG:  move_slider(gesture.dx);         break;
+      case EZLCD_GESTURE_SWIPE: next_page(gesture.direction);    break;
+      ...
+    }
+   @endcode
+ *
+ * Gesture timing uses ezLCD_event_clock(), so ezLCD_event_tick() must be
+ * running, e.g. with EZLCD_TOUCH_TIMER.
+ */
+#ifndef EZLCD_TOUCH_H
+#define EZLCD_TOUCH_H
+/*----------------------------------------------------------------------------*/
+/* INCLUDES                                                                   */
+/*----------------------------------------------------------------------------*/
+#include "ezLCD_103_common.h"
+
+/*----------------------------------------------------------------------------*/
+/* CONSTANTS                                                                  */
+/*----------------------------------------------------------------------------*/
+/** Returned by ezLCD_hit_test() when no region contains the point */
+#define EZLCD_HIT_NONE   0xFFFF
+
+/** Width and height of one cell of the hit index in pixels */
+#define EZLCD_HIT_CELL_WIDTH  ((EZLCD_WIDTH  + EZLCD_HIT_COLUMNS - 1) /       \
+                               EZLCD_HIT_COLUMNS)
+#define EZLCD_HIT_CELL_HEIGHT ((EZLCD_HEIGHT + EZLCD_HIT_ROWS - 1) /          \
+                               EZLCD_HIT_ROWS)
+
+/*----------------------------------------------------------------------------*/
+/* TYPES                                                                      */
+/*----------------------------------------------------------------------------*/
+/** What ezLCD_touch_poll() and ezLCD_touch_feed() decoded */
+typedef enum {EZLCD_TOUCH_NONE = 0,  /**< No complete report yet           */
+              EZLCD_TOUCH_DOWN,      /**< First position after pen down    */
+              EZLCD_TOUCH_MOVE,      /**< Any later position               */
+              EZLCD_TOUCH_UP         /**< Pen up, at the last position     */
+             } ezLCD_touch_kind_t;
+
+/** A decoded touch report */
+typedef struct
+{
+  ezLCD_touch_kind_t kind;
+  uint16_t           x;
+  uint16_t           y;
+} ezLCD_touch_t;
+
+/** A rectangular touch target. Regions may overlap, in which case the one
+ *  listed last wins, the same way it would be drawn last. */
+typedef struct
+{
+  uint16_t x;        /**< Left edge                              */
+  uint16_t y;        /**< Top edge                               */
+  uint16_t width;    /**< Width in pixels                        */
+  uint16_t height;   /**< Height in pixels                       */
+  uint16_t id;       /**< Returned by ezLCD_hit_test()           */
+} ezLCD_hit_region_t;
+
+/** A hit index built by ezLCD_hit_index_build(). The cells are stored one
+ *  after the other: the regions overlapping cell n are
+ *  entry[cell[n]] to entry[cell[n+1] - 1]. */
+typedef struct
+{
+  const EZLCD_FLASH ezLCD_hit_region_t *regions;
+  uint8_t cell[EZLCD_HIT_COLUMNS * EZLCD_HIT_ROWS + 1];
+  uint8_t entry[EZLCD_HIT_ENTRIES];
+} ezLCD_hit_index_t;
+
+/** What ezLCD_gesture_poll() and ezLCD_gesture_feed() recognized */
+typedef enum {EZLCD_GESTURE_NONE = 0,  /**< Nothing to report yet          */
+              EZLCD_GESTURE_TAP,       /**< Short touch without movement   */
+              EZLCD_GESTURE_LONG_PRESS,/**< Touch held without movement    */
+              EZLCD_GESTURE_DRAG,      /**< Movement while touched         */
+              EZLCD_GESTURE_SWIPE      /**< Fast movement, then release    */
+             } ezLCD_gesture_kind_t;
+
+/** Direction of a swipe */
+typedef enum {EZLCD_SWIPE_LEFT = 0,
+              EZLCD_SWIPE_RIGHT,
+              EZLCD_SWIPE_UP,
+              EZLCD_SWIPE_DOWN} ezLCD_swipe_t;
+
+/** A recognized gesture */
+typedef struct
+{
+  ezLCD_gesture_kind_t kind;
+  uint16_t      x;           /**< Where a tap or long press started, or the
+                                  current position of a drag or swipe   */
+  uint16_t      y;
+  int16_t       dx;          /**< Drag: movement since the last drag report.
+                                  Swipe: movement since the touch began */
+  int16_t       dy;
+  ezLCD_swipe_t direction;   /**< Swipe only */
+} ezLCD_gesture_t;
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS                                                                  */
+/*----------------------------------------------------------------------------*/
+/** Forgets any half received packet and the last pen position. Call it after
+ *  switching to the calibratedXY protocol.
+ */
+void ezLCD_touch_reset(void);
+
+/** Decodes one byte received from the display in calibratedXY mode. Bytes
+ *  which are not part of a packet, such as the 0x00 sent while idle, are
+ *  ignored.
+ *
+ *  @par Parameters
+ *       - @a data  = The received byte.
+ *       - @a touch = Receives the report when one is complete.
+ *
+ *  @returns The kind of report completed by this byte, or EZLCD_TOUCH_NONE.
+ *
+ *  @par Assumptions
+ *       - None.
+ */
+ezLCD_touch_kind_t ezLCD_touch_feed(uint8_t data, ezLCD_touch_t *touch);
+
+/** Filters a touch report in place; see the description of this module.
+ *  A pen down starts the filter over at the touched point and a pen up is
+ *  reported where the last move was.
+ *
+ *  @par Parameters
+ *       - @a touch = A report from ezLCD_touch_feed().
+ *
+ *  @returns The kind of the report, or EZLCD_TOUCH_NONE if it is a move
+ *           within the dead band and should be ignored.
+ *
+ *  @par Assumptions
+ *       - None.
+ */
+ezLCD_touch_kind_t ezLCD_touch_filter(ezLCD_touch_t *touch);
+
+/** Reads the next touch report from the display. Reports the display sent
+ *  during earlier drawing commands are taken first from the harvest queue
+ *  (see ezLCD_event_touch_get()), so a pen up is not lost to a redraw. Then
+ *  it returns at once when the display has nothing to send, otherwise keeps
+ *  reading until the report (an X and Y pair, or a pen up) is complete,
+ *  which takes at most 6 bytes. The report is passed through
+ *  ezLCD_touch_filter().
+ *
+ *  @par Parameters
+ *       - @a touch = Receives the report.
+ *
+ *  @returns The kind of report read, or EZLCD_TOUCH_NONE.
+ *
+ *  @par Assumptions
+ *       - calibratedXY was selected with ezLCD_set_touch_protocol(), which
+ *         also turns on harvesting of its packets.
+ *       - The user has initialized the MCU's SPI interface with the
+ *         EZLCD_INIT_SPI() macro.
+ *       - The user has set the MCU's SPI pins to inputs and outputs
+ *         appropriately. <BR><BR>
+ *         - SS_BAR = OUTPUT
+ *         - SCK    = OUTPUT
+ *         - MOSI   = OUTPUT
+ *         - MISO   = INPUT
+ */
+ezLCD_touch_kind_t ezLCD_touch_poll(ezLCD_touch_t *touch);
+
+/** Builds a hit index over a table of regions. The table is not copied, so it
+ *  must stay in place for as long as the index is used. Several indexes may
+ *  be built, one per page, and switched by using another one.
+ *
+ *  @par Parameters
+ *       - @a index   = The index to build.
+ *       - @a regions = The touch targets, normally a constant table in flash.
+ *       - @a count   = Number of entries in @a regions, at most 255.
+ *
+ *  @returns 1 on success, or 0 if there are more than 255 regions or they
+ *           overlap more than EZLCD_HIT_ENTRIES cells in total. The index is
+ *           then empty.
+ *
+ *  @par Assumptions
+ *       - None. Regions are clipped to the screen; those entirely off it
+ *         are never hit.
+ */
+uint8_t ezLCD_hit_index_build(ezLCD_hit_index_t *index,
+                              const EZLCD_FLASH ezLCD_hit_region_t *regions,
+                              uint16_t count);
+
+/** Finds the region containing a point.
+ *
+ *  @par Parameters
+ *       - @a index = An index built by ezLCD_hit_index_build().
+ *       - @a x     = X coordinate, as reported by ezLCD_touch_poll().
+ *       - @a y     = Y coordinate, as reported by ezLCD_touch_poll().
+ *
+ *  @returns The id of the region, or EZLCD_HIT_NONE.
+ *
+ *  @par Assumptions
+ *       - None.
+ */
+uint16_t ezLCD_hit_test(const ezLCD_hit_index_t *index, uint16_t x, uint16_t y);
+
+/** Forgets any touch in progress. Call it when a page changes so a touch
+ *  that began on the old page does not complete on the new one.
+ */
+void ezLCD_gesture_reset(void);
+
+/** Advances the gesture engine by one touch report, or by time alone.
+ *  Long presses and coalesced drags are reported by time, so this must also
+ *  be called while no report arrives.
+ *
+ *  @par Parameters
+ *       - @a touch   = A report from ezLCD_touch_poll() or ezLCD_touch_feed(),
+ *                      or one whose kind is EZLCD_TOUCH_NONE.
+ *       - @a now     = The current time in ticks of ezLCD_event_clock().
+ *       - @a gesture = Receives the gesture when one is recognized.
+ *
+ *  @returns The kind of gesture recognized, or EZLCD_GESTURE_NONE.
+ *
+ *  @par Assumptions
+ *       - None.
+ */
+ezLCD_gesture_kind_t ezLCD_gesture_feed(const ezLCD_touch_t *touch,
+                                        uint16_t now,
+                                        ezLCD_gesture_t *gesture);
+
+/** Reads the display with ezLCD_touch_poll() and passes the result to
+ *  ezLCD_gesture_feed() with the time from ezLCD_event_clock().
+ *
+ *  @par Parameters
+ *       - @a gesture = Receives the gesture when one is recognized.
+ *
+ *  @returns The kind of gesture recognized, or EZLCD_GESTURE_NONE.
+ *
+ *  @par Assumptions
+ *       - Same as ezLCD_touch_poll().
+ *       - ezLCD_event_tick() is called periodically.
+ */
+ezLCD_gesture_kind_t ezLCD_gesture_poll(ezLCD_gesture_t *gesture);
+
+#endif /* EZLCD_TOUCH_H */
+/** @} */ /* ezLCD_103_touch */
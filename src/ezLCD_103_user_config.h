@@ -19,7 +19,12 @@
 /* Includes                                                                   */
 /*----------------------------------------------------------------------------*/
 /** To change target, change this header file */
+#ifdef EZLCD_HOST_PORT
+#include "ezLCD_103_host_spi.h"   /* Emulated registers for PC builds */
+#else
 #include <iom128.h>
+#include <intrinsics.h>
+#endif /* EZLCD_HOST_PORT */
 
 
 /*----------------------------------------------------------------------------*/
@@ -76,6 +81,206 @@
 /** SPI Clock Speed  Bit 0 */
 #define EZLCD_SPR0                 0
 
+/*----------------------------------------------------------------------------*/
+/* TRANSFER SETTINGS                                                          */
+/*----------------------------------------------------------------------------*/
+/** Size in bytes of the command staging buffer used by ezLCD_cmd_put(). 
+ *  Commands longer than this are still sent under a single chip select, the
+ *  buffer is simply drained mid-command. Must be in the set [1,255].
+ */
+#define EZLCD_CMD_BUFFER_SIZE      16
+
+/** Uncomment to have commands drained by the SPI transfer complete interrupt
+ *  instead of busy-waiting on SPIF. Global interrupts must be enabled by the
+ *  user. Chip select frames the commands exactly as in polled mode. See
+ *  ezLCD_spi_wait().
+ */
+/* #define EZLCD_SPI_INTERRUPT */
+
+/** Size in bytes of the interrupt driven transmit ring. Must be a power of
+ *  two in the set [2,128]. Only used when EZLCD_SPI_INTERRUPT is defined.
+ */
+#define EZLCD_TX_RING_SIZE         64
+
+/** Size of the queue holding ezButton packets found on MISO while commands
+ *  are being sent. Must be a power of two in the set [2,128]. See
+ *  ezLCD_event_get().
+ */
+#define EZLCD_EVENT_QUEUE_SIZE     8
+
+/** Size of the queue holding calibratedXY packet bytes found on MISO while
+ *  commands are being sent, 3 per X or Y packet and 1 per PEN_UP. Must be a
+ *  power of two in the set [2,128]. See ezLCD_event_touch_get().
+ */
+#define EZLCD_TOUCH_QUEUE_SIZE     16
+
+/** Number of button IDs, from 0, whose definitions are remembered so that
+ *  ezLCD_button_page() only sends the buttons which change. Each takes 12
+ *  bytes of RAM. Must be in the set [1,64].
+ */
+#define EZLCD_BUTTON_CACHE_IDS     16
+
+/** Number of button IDs, from 0, an ezLCD_button_handlers_t has handlers
+ *  for. Each takes 3 function pointers, 6 bytes of RAM on the ATmega128,
+ *  per table. Must be in the set [1,64].
+ */
+#define EZLCD_BUTTON_HANDLER_IDS   16
+
+/** Uncomment to poll the display for touch events from the Timer0 compare
+ *  interrupt. See ezLCD_event_tick(). Global interrupts must be enabled by the
+ *  user.
+ */
+/* #define EZLCD_TOUCH_TIMER */
+
+/** Starts Timer0 in CTC mode with a 1 ms period at 16 MHz (clk/64, 250
+ *  counts). One tick of ezLCD_event_clock() is one period.
+ */
+#define EZLCD_INIT_TOUCH_TIMER()   OCR0  = 249;                               \
+                                   TCCR0 = (1 << WGM01) | (1 << CS02);        \
+                                   TIMSK |= (1 << OCIE0);
+
+/** Declares the touch polling timer interrupt handler */
+#ifndef EZLCD_TOUCH_TIMER_ISR
+#define EZLCD_TOUCH_TIMER_ISR()    _Pragma("vector = TIMER0_COMP_vect")       \
+                                   __interrupt void ezLCD_touch_timer_isr(void)
+#endif /* EZLCD_TOUCH_TIMER_ISR */
+
+/*----------------------------------------------------------------------------*/
+/* TOUCH POLLING                                                              */
+/*----------------------------------------------------------------------------*/
+/** Length of one polling interval unit in CPU cycles, 100 us at 16 MHz */
+#define EZLCD_POLL_UNIT_CYCLES     1600
+
+/** Interval in units between ezLCD_wait_for_event() polls right after a
+ *  touch. Each poll that finds nothing doubles the interval.
+ */
+#define EZLCD_POLL_FAST            1
+
+/** Longest interval in units between ezLCD_wait_for_event() polls, reached
+ *  after the screen has been idle for a while. 100 units = 10 ms.
+ */
+#define EZLCD_POLL_SLOW            100
+
+/** Called by ezLCD_wait_for_event() between polls with the interval in
+ *  units. The default busy-waits. To let the MCU sleep instead, redefine it
+ *  to sleep until a timer interrupt has elapsed @a units times, e.g. with
+ *  EZLCD_TOUCH_TIMER and __sleep().
+ */
+#ifndef EZLCD_POLL_IDLE
+#define EZLCD_POLL_IDLE(units)     { uint16_t ezlcd_n = (units);              \
+                                     while(ezlcd_n--)                         \
+                                       __delay_cycles(EZLCD_POLL_UNIT_CYCLES);\
+                                   }
+#endif /* EZLCD_POLL_IDLE */
+
+/** Ticks of ezLCD_event_clock() a button must be held before
+ *  ezLCD_button_dispatch() reports a long press. 500 ticks = 0.5 s with
+ *  EZLCD_INIT_TOUCH_TIMER().
+ */
+#define EZLCD_BUTTON_LONG_TICKS    500
+
+/** Grid of the calibratedXY hit index (see ezLCD_hit_index_build()). 8 x 6
+ *  cells of 40 x 40 pixels suit keys of that size or smaller. Each cell takes
+ *  1 byte of RAM in every ezLCD_hit_index_t, plus 1 byte.
+ */
+#define EZLCD_HIT_COLUMNS          8
+#define EZLCD_HIT_ROWS             6
+
+/** Cell entries per hit index, in the set [1,255]. A region takes one entry
+ *  for every cell it overlaps, so a keyboard of 40 keys of 32 x 40 pixels
+ *  needs 64. Each entry takes 1 byte of RAM in every ezLCD_hit_index_t, which
+ *  takes 179 bytes as configured here.
+ */
+#define EZLCD_HIT_ENTRIES          128
+
+/** Median filter length applied to calibratedXY positions by
+ *  ezLCD_touch_filter(), one of 1, 3, 5, 7 or 9. A median of n removes
+ *  spikes up to (n - 1) / 2 samples long at the cost of as many samples of
+ *  delay and 2 * (n - 1) bytes of RAM; 3 removes single-sample spikes, 1
+ *  turns the median off. Other values stop the build.
+ */
+#define EZLCD_TOUCH_MEDIAN         3
+
+/** Weight of a new position in the smoothing of ezLCD_touch_filter(),
+ *  1/2^n. Smoothing lags the finger by about 2^n - 1 samples on top of the
+ *  median's one, so it is off (0) by default; 1 suits a noisy panel where
+ *  the extra sample of lag is acceptable.
+ */
+#define EZLCD_TOUCH_SMOOTH_SHIFT   0
+
+/** Movement in pixels, on both axes, that ezLCD_touch_filter() drops as
+ *  jitter. 0 passes every change on.
+ */
+#define EZLCD_TOUCH_DEADBAND       2
+
+/** Pixels a touch may wander before it counts as a drag rather than a tap
+ *  or long press.
+ */
+#define EZLCD_GESTURE_SLOP         8
+
+/** Ticks a touch must be held still to be a long press. 500 ticks = 0.5 s
+ *  with EZLCD_INIT_TOUCH_TIMER().
+ */
+#define EZLCD_GESTURE_LONG_TICKS   500
+
+/** Least ticks between two drag reports. Samples arriving in between are
+ *  added to the next report. 40 ticks = at most 25 redraws per second; 0
+ *  reports every sample.
+ */
+#define EZLCD_GESTURE_DRAG_TICKS   40
+
+/** A drag released within this many ticks of the touch and at least
+ *  EZLCD_GESTURE_SWIPE_PIXELS from where it began is a swipe.
+ */
+#define EZLCD_GESTURE_SWIPE_TICKS  300
+#define EZLCD_GESTURE_SWIPE_PIXELS 40
+
+/** Frames holding pages pre-rendered by ezLCD_page_show():
+ *  EZLCD_PAGE_FRAMES frames from EZLCD_PAGE_FIRST_FRAME on. Frames 0 and 1
+ *  are left to ezLCD_begin_frame() and ezLCD_present(). The display has 20
+ *  frames, so EZLCD_PAGE_FIRST_FRAME + EZLCD_PAGE_FRAMES must not exceed 20.
+ */
+#define EZLCD_PAGE_FIRST_FRAME     2
+#define EZLCD_PAGE_FRAMES          4
+
+/** Characters putchar() holds back while buffering, see
+ *  ezLCD_putchar_buffer(). Must be in the set [1,255].
+ */
+#define EZLCD_PUTCHAR_BUFFER_SIZE  32
+
+/** Widest field ezLCD_print_int() and its kind pad a number to. Must be at
+ *  least 12, the length of -2147483648 with a decimal point.
+ */
+#define EZLCD_PRINT_WIDTH          16
+
+/** Line ring of the text console, see ezLCD_console_begin(): the last
+ *  EZLCD_CONSOLE_LINES lines of up to EZLCD_CONSOLE_COLUMNS characters,
+ *  shown in up to EZLCD_CONSOLE_ROWS rows. EZLCD_CONSOLE_LINES must be a
+ *  power of two in the set [2,128] and at least EZLCD_CONSOLE_ROWS. Takes
+ *  about LINES x (COLUMNS + 1) + ROWS x 5 bytes of RAM.
+ */
+#define EZLCD_CONSOLE_LINES        16
+#define EZLCD_CONSOLE_COLUMNS      20
+#define EZLCD_CONSOLE_ROWS         8
+
+/** Qualifier placing constant tables, such as display lists, in flash */
+#ifndef EZLCD_FLASH
+#define EZLCD_FLASH                __flash
+#endif /* EZLCD_FLASH */
+
+/** Declares the SPI transfer complete interrupt handler */
+#ifndef EZLCD_SPI_ISR
+#define EZLCD_SPI_ISR()            _Pragma("vector = SPI_STC_vect")           \
+                                   __interrupt void ezLCD_spi_isr(void)
+#endif /* EZLCD_SPI_ISR */
+
+/** Begins a section of code which must not be interrupted */
+#define EZLCD_CRITICAL_ENTER()     { unsigned char ezlcd_sreg =               \
+                                     __save_interrupt();                      \
+                                     __disable_interrupt();
+/** Ends a section of code started with EZLCD_CRITICAL_ENTER() */
+#define EZLCD_CRITICAL_EXIT()        __restore_interrupt(ezlcd_sreg); }
+
 
 /*----------------------------------------------------------------------------*/
 /* BITMAP FONT INDICES                                                        */
@@ -4,7 +4,6 @@
 #include <iom128.h>
 #include <intrinsics.h>
 #include <avr_macros.h>
-#include <stdio.h>
 
 #include "ezLCD_103_driver.h"
 
@@ -29,26 +28,270 @@
 
 
 /*----------------------------------------------------------------------------*/
-/* PROTOTYPES                                                                 */
+/* SCREEN TABLES                                                              */
 /*----------------------------------------------------------------------------*/
-void draw_buttons();
-void draw_number_pad(uint8_t num_pad_x, uint8_t num_pad_y);
+/* Used to keep numbers grouped together neatly */
+#define NUMBER_PAD(num_pad_x, num_pad_y)                                      \
+  { ZERO,                                                                     \
+    EZLCD_BUTTON_UP,                                                          \
+    ZERO_BUTTON_EZLCD_BUTTON_UP_INDEX,                                        \
+    ZERO_BUTTON_EZLCD_BUTTON_DOWN_INDEX,                                      \
+    ZERO_BUTTON_DISABLED_INDEX,                                               \
+    num_pad_x + 50 + 5,                                                       \
+    num_pad_y + 105 + 15,                                                     \
+    ZERO_BUTTON_WIDTH,                                                        \
+    ZERO_BUTTON_HEIGHT },                                                     \
+  { ONE,                                                                      \
+    EZLCD_BUTTON_UP,                                                          \
+    ONE_BUTTON_EZLCD_BUTTON_UP_INDEX,                                         \
+    ONE_BUTTON_EZLCD_BUTTON_DOWN_INDEX,                                       \
+    ONE_BUTTON_DISABLED_INDEX,                                                \
+    num_pad_x,                                                                \
+    num_pad_y,                                                                \
+    ONE_BUTTON_WIDTH,                                                         \
+    ONE_BUTTON_HEIGHT },                                                      \
+  { TWO,                                                                      \
+    EZLCD_BUTTON_UP,                                                          \
+    TWO_BUTTON_EZLCD_BUTTON_UP_INDEX,                                         \
+    TWO_BUTTON_EZLCD_BUTTON_DOWN_INDEX,                                       \
+    TWO_BUTTON_DISABLED_INDEX,                                                \
+    num_pad_x + 50 + 5,                                                       \
+    num_pad_y,                                                                \
+    TWO_BUTTON_WIDTH,                                                         \
+    TWO_BUTTON_HEIGHT },                                                      \
+  { THREE,                                                                    \
+    EZLCD_BUTTON_UP,                                                          \
+    THREE_BUTTON_EZLCD_BUTTON_UP_INDEX,                                       \
+    THREE_BUTTON_EZLCD_BUTTON_DOWN_INDEX,                                     \
+    THREE_BUTTON_DISABLED_INDEX,                                              \
+    num_pad_x + 100 + 10,                                                     \
+    num_pad_y,                                                                \
+    THREE_BUTTON_WIDTH,                                                       \
+    THREE_BUTTON_HEIGHT },                                                    \
+  { FOUR,                                                                     \
+    EZLCD_BUTTON_UP,                                                          \
+    FOUR_BUTTON_EZLCD_BUTTON_UP_INDEX,                                        \
+    FOUR_BUTTON_EZLCD_BUTTON_DOWN_INDEX,                                      \
+    FOUR_BUTTON_DISABLED_INDEX,                                               \
+    num_pad_x,                                                                \
+    num_pad_y + 35 + 5,                                                       \
+    FOUR_BUTTON_WIDTH,                                                        \
+    FOUR_BUTTON_HEIGHT },                                                     \
+  { FIVE,                                                                     \
+    EZLCD_BUTTON_UP,                                                          \
+    FIVE_BUTTON_EZLCD_BUTTON_UP_INDEX,                                        \
+    FIVE_BUTTON_EZLCD_BUTTON_DOWN_INDEX,                                      \
+    FIVE_BUTTON_DISABLED_INDEX,                                               \
+    num_pad_x + 50 + 5,                                                       \
+    num_pad_y + 35 + 5,                                                       \
+    FIVE_BUTTON_WIDTH,                                                        \
+    FIVE_BUTTON_HEIGHT },                                                     \
+  { SIX,                                                                      \
+    EZLCD_BUTTON_UP,                                                          \
+    SIX_BUTTON_EZLCD_BUTTON_UP_INDEX,                                         \
+    SIX_BUTTON_EZLCD_BUTTON_DOWN_INDEX,                                       \
+    SIX_BUTTON_DISABLED_INDEX,                                                \
+    num_pad_x + 100 + 10,                                                     \
+    num_pad_y + 35 + 5,                                                       \
+    SIX_BUTTON_WIDTH,                                                         \
+    SIX_BUTTON_HEIGHT },                                                      \
+  { SEVEN,                                                                    \
+    EZLCD_BUTTON_UP,                                                          \
+    SEVEN_BUTTON_EZLCD_BUTTON_UP_INDEX,                                       \
+    SEVEN_BUTTON_EZLCD_BUTTON_DOWN_INDEX,                                     \
+    SEVEN_BUTTON_DISABLED_INDEX,                                              \
+    num_pad_x,                                                                \
+    num_pad_y + 70 + 10,                                                      \
+    SEVEN_BUTTON_WIDTH,                                                       \
+    SEVEN_BUTTON_HEIGHT },                                                    \
+  { EIGHT,                                                                    \
+    EZLCD_BUTTON_UP,                                                          \
+    EIGHT_BUTTON_EZLCD_BUTTON_UP_INDEX,                                       \
+    EIGHT_BUTTON_EZLCD_BUTTON_DOWN_INDEX,                                     \
+    EIGHT_BUTTON_DISABLED_INDEX,                                              \
+    num_pad_x + 50 + 5,                                                       \
+    num_pad_y + 70 + 10,                                                      \
+    EIGHT_BUTTON_WIDTH,                                                       \
+    EIGHT_BUTTON_HEIGHT },                                                    \
+  { NINE,                                                                     \
+    EZLCD_BUTTON_UP,                                                          \
+    NINE_BUTTON_EZLCD_BUTTON_UP_INDEX,                                        \
+    NINE_BUTTON_EZLCD_BUTTON_DOWN_INDEX,                                      \
+    NINE_BUTTON_DISABLED_INDEX,                                               \
+    num_pad_x + 100 + 10,                                                     \
+    num_pad_y + 70 + 10,                                                      \
+    NINE_BUTTON_WIDTH,                                                        \
+    NINE_BUTTON_HEIGHT },                                                     \
+  { STAR,                                                                     \
+    EZLCD_BUTTON_UP,                                                          \
+    STAR_BUTTON_EZLCD_BUTTON_UP_INDEX,                                        \
+    STAR_BUTTON_EZLCD_BUTTON_DOWN_INDEX,                                      \
+    STAR_BUTTON_DISABLED_INDEX,                                               \
+    num_pad_x,                                                                \
+    num_pad_y + 105 + 15,                                                     \
+    STAR_BUTTON_WIDTH,                                                        \
+    STAR_BUTTON_HEIGHT },                                                     \
+  { POUND,                                                                    \
+    EZLCD_BUTTON_UP,                                                          \
+    POUND_BUTTON_EZLCD_BUTTON_UP_INDEX,                                       \
+    POUND_BUTTON_EZLCD_BUTTON_DOWN_INDEX,                                     \
+    POUND_BUTTON_DISABLED_INDEX,                                              \
+    num_pad_x + 100 + 10,                                                     \
+    num_pad_y + 105 + 15,                                                     \
+    POUND_BUTTON_WIDTH,                                                       \
+    POUND_BUTTON_HEIGHT }
+
+#define START_BUTTON                                                          \
+  { START,                                                                    \
+    EZLCD_BUTTON_UP,                                                          \
+    START_BUTTON_EZLCD_BUTTON_UP_INDEX,                                       \
+    START_BUTTON_EZLCD_BUTTON_DOWN_INDEX,                                     \
+    START_BUTTON_DISABLED_INDEX,                                              \
+    215,                                                                      \
+    5,                                                                        \
+    START_BUTTON_WIDTH,                                                       \
+    START_BUTTON_HEIGHT }
+
+#define STOP_BUTTON                                                           \
+  { STOP,                                                                     \
+    EZLCD_BUTTON_UP,                                                          \
+    STOP_BUTTON_EZLCD_BUTTON_UP_INDEX,                                        \
+    STOP_BUTTON_EZLCD_BUTTON_DOWN_INDEX,                                      \
+    STOP_BUTTON_DISABLED_INDEX,                                               \
+    215,                                                                      \
+    60,                                                                       \
+    STOP_BUTTON_WIDTH,                                                        \
+    STOP_BUTTON_HEIGHT }
+
+#define CALIBRATE_BUTTON                                                      \
+  { CALIBRATE,                                                                \
+    EZLCD_BUTTON_UP,                                                          \
+    CALIBRATE_BUTTON_EZLCD_BUTTON_UP_INDEX,                                   \
+    CALIBRATE_BUTTON_EZLCD_BUTTON_DOWN_INDEX,                                 \
+    CALIBRATE_BUTTON_DISABLED_INDEX,                                          \
+    215,                                                                      \
+    115,                                                                      \
+    CALIBRATE_BUTTON_WIDTH,                                                   \
+    CALIBRATE_BUTTON_HEIGHT }
+
+/* Number of entries of a table */
+#define ELEMENTS(table)  (sizeof(table) / sizeof((table)[0]))
+
+/* The buttons of the START page */
+static const EZLCD_FLASH ezLCD_button_t start_buttons[] =
+{
+  NUMBER_PAD(5, 80),
+  START_BUTTON,
+  STOP_BUTTON,
+  CALIBRATE_BUTTON
+};
+
+/* The buttons of the STOP page, the number pad is hidden */
+static const EZLCD_FLASH ezLCD_button_t stop_buttons[] =
+{
+  CALIBRATE_BUTTON,
+  START_BUTTON,
+  STOP_BUTTON
+};
+
+/*----------------------------------------------------------------------------*/
+/* BUTTON HANDLERS                                                            */
+/*----------------------------------------------------------------------------*/
+/* One handler per button ID and event, see ezLCD_button_dispatch() */
+static ezLCD_button_handlers_t handlers;
+
+static void on_calibrate(uint8_t id, ezLCD_event_t event)
+{
+  ezLCD_calibrate_screen();                    /* Calibrate the screen */
+  ezLCD_page_invalidate_all();   /* Calibrating draws over the page shown */
+  
+  /* Reset font, there appears to be a bug with the display itself where 
+   *calibrating changes the font size
+   */
+  ezLCD_set_true_type_font(DEJAVUSANS_BOLD,32,32);
+}
+
+/* Zero through 9 */
+static void on_digit(uint8_t id, ezLCD_event_t event)
+{
+  ezLCD_print_uint(id, 0, ' ');   /* Print the button ID to the text box */
+}
+
+/* Change the font mid-program and print a magical character */
+static void on_star(uint8_t id, ezLCD_event_t event)
+{
+  ezLCD_set_true_type_font(WALTOGRAPH,32,32);
+  ezLCD_set_ttf_unicode_base(0x245);
+  putchar(2);
+  ezLCD_set_true_type_font(DEJAVUSANS_BOLD,32,32);
+  ezLCD_set_ttf_unicode_base(0);
+}
+
+/* If Pound button, print Greek letter Delta (TTF Fonts Only!)*/
+static void on_pound(uint8_t id, ezLCD_event_t event)
+{
+  ezLCD_set_ttf_unicode_base(0x394);
+  putchar(0);
+  ezLCD_set_ttf_unicode_base(0);
+}
+
+/* Number pad and text box. The digits typed change it, so it is drawn on
+ * the back frame and presented each time rather than kept as a page. */
+static void show_start_page(void)
+{
+  ezLCD_begin_frame();
+  ezLCD_set_xy(0,0);
+  ezLCD_put_picture_rom(BACKGROUND_1_INDEX);
+  ezLCD_button_page(start_buttons, ELEMENTS(start_buttons), 1);
+  ezLCD_present();
+  ezLCD_button_page(start_buttons, ELEMENTS(start_buttons), 0);
+  
+  /* Text goes to the frame just presented */
+  ezLCD_init_putchar(5, 5, 165-5, 70-5, 2, 2, 32,32,EZLCD_WHITE,EZLCD_VIOLET);
+  ezLCD_set_true_type_font(DEJAVUSANS_BOLD,32,32);
+}
+
+/* Background and the three command buttons only, kept in a frame of its
+ * own */
+static void draw_stop_page(void)
+{
+  ezLCD_set_xy(0,0);
+  ezLCD_put_picture_rom(BACKGROUND_1_INDEX);
+  ezLCD_button_page(stop_buttons, ELEMENTS(stop_buttons), 1);
+}
+static ezLCD_page_t stop_page = EZLCD_PAGE(draw_stop_page);
+
+/* Clear screen of number pad and text box */
+static void on_stop(uint8_t id, ezLCD_event_t event)
+{
+  ezLCD_page_show(&stop_page);
+  ezLCD_button_page(stop_buttons, ELEMENTS(stop_buttons), 0);
+}
+
+/* Restore numberpad and text box */
+static void on_start(uint8_t id, ezLCD_event_t event)
+{
+  show_start_page();
+}
 
 /*----------------------------------------------------------------------------*/
 /* FUNCTIONS                                                                  */
 /*----------------------------------------------------------------------------*/
 int main (void)
 {  
+  uint8_t  id;
+  uint16_t interval = EZLCD_POLL_FAST;
+  
   DDRB  = (1<<EZLCD_POWER_PIN) |    //power pin output
           (0<<EZLCD_MISO_PIN)  |    //MISO pin input
           (1<<EZLCD_MOSI_PIN)  |    //MOSI pin output
           (1<<EZLCD_SCK_PIN)   |    //SCK pin output
           (1<<EZLCD_SS_BAR_PIN);    //SS_BAR pin output
   
-  EZLCD_POWER_OFF()
+  EZLCD_POWER_OFF();
   EZLCD_INIT_SPI();
   __delay_cycles(10000);
-  EZLCD_POWER_ON()
+  EZLCD_POWER_ON();
   
   /* Wait until display is fully powered and ready */
   while(!ezLCD_ping());
@@ -56,269 +299,41 @@ int main (void)
   /* Clear the screen contents */
   ezLCD_clear();
   
-  /* Place background image */
-  ezLCD_put_picture_rom(BACKGROUND_1_INDEX);
-  
   /* Set touch protocol */
   ezLCD_set_touch_protocol(ezButton);
   
-  /* Draw buttons on the screen */
-  draw_buttons();
+  /* Draw the STOP page into a frame of its own, then show the START page
+   * with putchar() and the font set up for its text box */
+  ezLCD_page_prepare(&stop_page);
+  show_start_page();
   
-  /* Initialize the putchar() function */
-  ezLCD_init_putchar(5, 5, 165-5, 70-5, 2, 2, 32,32,EZLCD_WHITE,EZLCD_VIOLET);
+  /* Hold text back until each event has been handled */
+  ezLCD_putchar_buffer(1);
   
-  /* Set the font */
-  ezLCD_set_true_type_font(DEJAVUSANS_BOLD,32,32);
+  /* Buttons act when released */
+  for(id = ZERO; id <= NINE; ++id)
+    ezLCD_button_on(&handlers, id, EZLCD_EVENT_RELEASE, on_digit);
+  ezLCD_button_on(&handlers, STAR,      EZLCD_EVENT_RELEASE, on_star);
+  ezLCD_button_on(&handlers, POUND,     EZLCD_EVENT_RELEASE, on_pound);
+  ezLCD_button_on(&handlers, START,     EZLCD_EVENT_RELEASE, on_start);
+  ezLCD_button_on(&handlers, STOP,      EZLCD_EVENT_RELEASE, on_stop);
+  ezLCD_button_on(&handlers, CALIBRATE, EZLCD_EVENT_RELEASE, on_calibrate);
+  ezLCD_button_handlers_use(&handlers);
   
   while(1)
   {
-    /* Wait for button press */
-    uint8_t button = ezLCD_wait_for_event();
-    
-    /* Case on the button */
-    if(button == CALIBRATE)
+    /* Handle button events, polling less often while nothing happens */
+    if(ezLCD_button_dispatch() != EZLCD_EVENT_NONE)
     {
-        ezLCD_calibrate_screen();                  /* Calibrate the screen */
-        
-        /* Reset font, there appears to be a bug with the display itself where 
-         *calibrating changes the font size
-         */
-        ezLCD_set_true_type_font(DEJAVUSANS_BOLD,32,32);
+      ezLCD_putchar_flush();
+      interval = EZLCD_POLL_FAST;
     }
-    /* Zero through 9 */
-    if(button <= NINE)
-       printf("%d",button);            /* Print the button ID to the text box */
-    
-    /* Change the font mid-program and print a magical character */
-    if(button == STAR)
+    else
     {
-      ezLCD_set_true_type_font(WALTOGRAPH,32,32);
-      ezLCD_set_ttf_unicode_base(0x245);
-      putchar(2);
-      ezLCD_set_true_type_font(DEJAVUSANS_BOLD,32,32);
-      ezLCD_set_ttf_unicode_base(0);
-    }
-    
-    /* If Pound button, print Greek letter Delta (TTF Fonts Only!)*/
-    if(button == POUND)
-    {
-      ezLCD_set_ttf_unicode_base(0x394);
-      putchar(0);
-      ezLCD_set_ttf_unicode_base(0);
-     }
-    
-    /* Clear screen of number pad and text box */
-    if(button == STOP)
-    {
-      ezLCD_set_draw_frame(1);
-      ezLCD_deactivate_all_buttons();
-      ezLCD_set_xy(0,0);
-      ezLCD_put_picture_rom(BACKGROUND_1_INDEX);
-      
-       ezLCD_button_define_long(14,
-                         EZLCD_BUTTON_UP,
-                         CALIBRATE_BUTTON_EZLCD_BUTTON_UP_INDEX,
-                         CALIBRATE_BUTTON_EZLCD_BUTTON_DOWN_INDEX,
-                         CALIBRATE_BUTTON_DISABLED_INDEX,
-                         215,
-                         115,
-                         CALIBRATE_BUTTON_WIDTH,
-                         CALIBRATE_BUTTON_HEIGHT);
-       ezLCD_button_define_long(START,
-                           EZLCD_BUTTON_UP,
-                           START_BUTTON_EZLCD_BUTTON_UP_INDEX,
-                           START_BUTTON_EZLCD_BUTTON_DOWN_INDEX,
-                           START_BUTTON_DISABLED_INDEX,
-                           215,
-                           5,
-                           START_BUTTON_WIDTH,
-                           START_BUTTON_HEIGHT);
-  
-       ezLCD_button_define_long(STOP,
-                           EZLCD_BUTTON_UP,
-                           STOP_BUTTON_EZLCD_BUTTON_UP_INDEX,
-                           STOP_BUTTON_EZLCD_BUTTON_DOWN_INDEX,
-                           STOP_BUTTON_DISABLED_INDEX,
-                           215,
-                           60,
-                           STOP_BUTTON_WIDTH,
-                           STOP_BUTTON_HEIGHT);
-       ezLCD_set_display_frame(1);
-    }
-    
-    /* Restore numberpad and text box */
-    if(button == START)
-    {
-      ezLCD_set_draw_frame(1);
-      ezLCD_deactivate_all_buttons();
-      ezLCD_set_xy(0,0);
-      ezLCD_put_picture_rom(BACKGROUND_1_INDEX);
-      draw_buttons();
-      ezLCD_init_putchar(5, 5, 165-5, 70-5, 2, 2, 32,32,EZLCD_WHITE,EZLCD_VIOLET);
-      ezLCD_set_true_type_font(DEJAVUSANS_BOLD,32,32);
-      ezLCD_set_display_frame(1);
+      EZLCD_POLL_IDLE(interval);
+      interval = (interval > EZLCD_POLL_SLOW / 2) ? EZLCD_POLL_SLOW
+                                                  : interval * 2;
     }
   }
 
 }
-
-void draw_buttons()
-{  
-  draw_number_pad(5,80); 
-  
-  ezLCD_button_define_long(START,
-                           EZLCD_BUTTON_UP,
-                           START_BUTTON_EZLCD_BUTTON_UP_INDEX,
-                           START_BUTTON_EZLCD_BUTTON_DOWN_INDEX,
-                           START_BUTTON_DISABLED_INDEX,
-                           215,
-                           5,
-                           START_BUTTON_WIDTH,
-                           START_BUTTON_HEIGHT);
-  
-  ezLCD_button_define_long(STOP,
-                           EZLCD_BUTTON_UP,
-                           STOP_BUTTON_EZLCD_BUTTON_UP_INDEX,
-                           STOP_BUTTON_EZLCD_BUTTON_DOWN_INDEX,
-                           STOP_BUTTON_DISABLED_INDEX,
-                           215,
-                           60,
-                           STOP_BUTTON_WIDTH,
-                           STOP_BUTTON_HEIGHT);
-  
-  ezLCD_button_define_long(CALIBRATE,
-                           EZLCD_BUTTON_UP,
-                           CALIBRATE_BUTTON_EZLCD_BUTTON_UP_INDEX,
-                           CALIBRATE_BUTTON_EZLCD_BUTTON_DOWN_INDEX,
-                           CALIBRATE_BUTTON_DISABLED_INDEX,
-                           215,
-                           115,
-                           CALIBRATE_BUTTON_WIDTH,
-                           CALIBRATE_BUTTON_HEIGHT);
-        
-
-}
-
-/* Used to keep numbers grouped together neatly */
-void draw_number_pad(uint8_t num_pad_x, uint8_t num_pad_y)
-{
-  ezLCD_button_define_long(ZERO,
-                          EZLCD_BUTTON_UP,
-                          ZERO_BUTTON_EZLCD_BUTTON_UP_INDEX,
-                          ZERO_BUTTON_EZLCD_BUTTON_DOWN_INDEX,
-                          ZERO_BUTTON_DISABLED_INDEX,
-                          num_pad_x + 50 + 5,
-                          num_pad_y + 105 + 15,
-                          ZERO_BUTTON_WIDTH,
-                          ZERO_BUTTON_HEIGHT);
-   ezLCD_button_define_long(ONE,
-                           EZLCD_BUTTON_UP,
-                           ONE_BUTTON_EZLCD_BUTTON_UP_INDEX,
-                           ONE_BUTTON_EZLCD_BUTTON_DOWN_INDEX,
-                           ONE_BUTTON_DISABLED_INDEX,
-                           num_pad_x,
-                           num_pad_y,
-                           ONE_BUTTON_WIDTH,
-                           ONE_BUTTON_HEIGHT);
-    
-   ezLCD_button_define_long(TWO,
-                           EZLCD_BUTTON_UP,
-                           TWO_BUTTON_EZLCD_BUTTON_UP_INDEX,
-                           TWO_BUTTON_EZLCD_BUTTON_DOWN_INDEX,
-                           TWO_BUTTON_DISABLED_INDEX,
-                           num_pad_x + 50 + 5,
-                           num_pad_y,
-                           TWO_BUTTON_WIDTH,
-                           TWO_BUTTON_HEIGHT);
-   
-   ezLCD_button_define_long(THREE,
-                           EZLCD_BUTTON_UP,
-                           THREE_BUTTON_EZLCD_BUTTON_UP_INDEX,
-                           THREE_BUTTON_EZLCD_BUTTON_DOWN_INDEX,
-                           THREE_BUTTON_DISABLED_INDEX,
-                           num_pad_x + 100 + 10,
-                           num_pad_y,
-                           THREE_BUTTON_WIDTH,
-                           THREE_BUTTON_HEIGHT);
-   
-   ezLCD_button_define_long(FOUR,
-                           EZLCD_BUTTON_UP,
-                           FOUR_BUTTON_EZLCD_BUTTON_UP_INDEX,
-                           FOUR_BUTTON_EZLCD_BUTTON_DOWN_INDEX,
-                           FOUR_BUTTON_DISABLED_INDEX,
-                           num_pad_x,
-                           num_pad_y + 35 + 5,
-                           FOUR_BUTTON_WIDTH,
-                           FOUR_BUTTON_HEIGHT);
-   
-   ezLCD_button_define_long(FIVE,
-                           EZLCD_BUTTON_UP,
-                           FIVE_BUTTON_EZLCD_BUTTON_UP_INDEX,
-                           FIVE_BUTTON_EZLCD_BUTTON_DOWN_INDEX,
-                           FIVE_BUTTON_DISABLED_INDEX,
-                           num_pad_x + 50 + 5,
-                           num_pad_y + 35 + 5,
-                           FIVE_BUTTON_WIDTH,
-                           FIVE_BUTTON_HEIGHT);
-   
-   ezLCD_button_define_long(SIX,
-                           EZLCD_BUTTON_UP,
-                           SIX_BUTTON_EZLCD_BUTTON_UP_INDEX,
-                           SIX_BUTTON_EZLCD_BUTTON_DOWN_INDEX,
-                           SIX_BUTTON_DISABLED_INDEX,
-                           num_pad_x + 100 + 10,
-                           num_pad_y + 35 + 5,
-                           SIX_BUTTON_WIDTH,
-                           SIX_BUTTON_HEIGHT);
-   
-   ezLCD_button_define_long(SEVEN,
-                           EZLCD_BUTTON_UP,
-                           SEVEN_BUTTON_EZLCD_BUTTON_UP_INDEX,
-                           SEVEN_BUTTON_EZLCD_BUTTON_DOWN_INDEX,
-                           SEVEN_BUTTON_DISABLED_INDEX,
-                           num_pad_x,
-                           num_pad_y + 70 + 10,
-                           SEVEN_BUTTON_WIDTH,
-                           SEVEN_BUTTON_HEIGHT);
-   
-   ezLCD_button_define_long(EIGHT,
-                           EZLCD_BUTTON_UP,
-                           EIGHT_BUTTON_EZLCD_BUTTON_UP_INDEX,
-                           EIGHT_BUTTON_EZLCD_BUTTON_DOWN_INDEX,
-                           EIGHT_BUTTON_DISABLED_INDEX,
-                           num_pad_x + 50 + 5,
-                           num_pad_y + 70 + 10,
-                           EIGHT_BUTTON_WIDTH,
-                           EIGHT_BUTTON_HEIGHT);
-   
-   ezLCD_button_define_long(NINE,
-                           EZLCD_BUTTON_UP,
-                           NINE_BUTTON_EZLCD_BUTTON_UP_INDEX,
-                           NINE_BUTTON_EZLCD_BUTTON_DOWN_INDEX,
-                           NINE_BUTTON_DISABLED_INDEX,
-                           num_pad_x + 100 + 10,
-                           num_pad_y + 70 + 10,
-                           NINE_BUTTON_WIDTH,
-                           NINE_BUTTON_HEIGHT);
-   
-  ezLCD_button_define_long(STAR,
-                           EZLCD_BUTTON_UP,
-                           STAR_BUTTON_EZLCD_BUTTON_UP_INDEX,
-                           STAR_BUTTON_EZLCD_BUTTON_DOWN_INDEX,
-                           STAR_BUTTON_DISABLED_INDEX,
-                           num_pad_x,
-                           num_pad_y + 105 + 15,
-                           STAR_BUTTON_WIDTH,
-                           STAR_BUTTON_HEIGHT);
-   
-  ezLCD_button_define_long(POUND,
-                           EZLCD_BUTTON_UP,
-                           POUND_BUTTON_EZLCD_BUTTON_UP_INDEX,
-                           POUND_BUTTON_EZLCD_BUTTON_DOWN_INDEX,
-                           POUND_BUTTON_DISABLED_INDEX,
-                           num_pad_x + 100 + 10,
-                           num_pad_y + 105 + 15,
-                           POUND_BUTTON_WIDTH,
-                           POUND_BUTTON_HEIGHT);
-}
\ No newline at end of file